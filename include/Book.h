@@ -1,62 +1,1362 @@
 #ifndef BOOK_H
 #define BOOK_H
 
-#include "Bitmask.h"
+#include "DepthCache.h"
 #include "Limit.h"
+#include "MappedFile.h"
 #include "ObjectPool.h"
 #include "Order.h"
+#include "OrderIndex.h"
+#include "ExecutionBuffer.h"
+#include "LatencyHistogram.h"
+#include "FlatPriceLadder.h"
+#include "PriceLadder.h"
+#include "Snapshot.h"
+#include "TradeListener.h"
+#include "Tsc.h"
+#include "VolumeTree.h"
 
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
-using TradeCallback = std::function<void(const Trade&)>;
+// submitBatch() look-ahead, in commands. Each command is prefetched in three dependent
+// stages, each one once the previous stage's line should have arrived:
+// index slot / ladder slot, then the Order / Limit, then the order's level and neighbours
+// (or the level's tail order).
+constexpr size_t BATCH_PREFETCH_SLOT = 12;
+constexpr size_t BATCH_PREFETCH_ENTRY = 8;
+constexpr size_t BATCH_PREFETCH_LINKS = 4;
 
-class Book {
+// Book is templated on its trade listener so the per-fill notification is resolved
+// at compile time (see TradeListener.h), on its OrderId index (see OrderIndex.h) and on
+// its price ladder (PriceLadder.h, or FlatPriceLadder.h for inline level headers).
+// `Book` keeps the runtime-callback API.
+template <typename Listener = NoopListener, typename Index = HashOrderIndex, typename Ladder = PriceLadder>
+class BasicBook {
 private:
     // Bids (Buys): Ordered High-to-Low (Highest bidder is best)
-    std::vector<Limit*> bids;
+    Ladder bids;
     // Asks (Sells): Ordered Low-to-High (Lowest seller is best)
-    std::vector<Limit*> asks;
-
-    Bitmask bidsMask;
-    Bitmask asksMask;
+    Ladder asks;
 
     Price highestBid = 0;
     Price lowestAsk = MAX_PRICE;
 
+    // Top-N L2 levels per side, kept in step with the ladders
+    DepthCache<Side::BUY> bidDepth;
+    DepthCache<Side::SELL> askDepth;
+
     // Fast Lookup: Hash Map OrderID -> Order Object
-    std::vector<Order*> orderMap;
+    Index orderMap;
 
     // Object pools
     ObjectPool<Order> orderPool;
-    ObjectPool<Limit> limitPool;
 
-    // For Benchmarking (Observer)
-    TradeCallback tradeListener = nullptr;
+    // Trade Observer (compile-time policy)
+    [[no_unique_address]] Listener listener;
+
+    // Per-operation latency of process(), allocated only while enabled
+    std::unique_ptr<OperationLatency> latencyStats;
+
+    // Cumulative volume over each ladder's window, allocated only while enabled
+    std::unique_ptr<VolumeTree> bidVolume;
+    std::unique_ptr<VolumeTree> askVolume;
+
+    // Pending stop orders per side, queued by trigger price (allocated on first use)
+    std::unique_ptr<Ladder> buyStops;
+    std::unique_ptr<Ladder> sellStops;
+    // Next trigger per side: buy stops fire at or above, sell stops at or below
+    // (MAX_PRICE / 0 when the side has none)
+    Price lowestBuyStop = MAX_PRICE;
+    Price highestSellStop = 0;
+    // Price of the most recent fill (0 before the first one)
+    Price lastTradePrice = 0;
 
-    void updateBestBid();
-    void updateBestAsk();
-    void matchOrder(OrderId makerId, Price price, Quantity& fillQty, Side side);
+    // Quantity, notional and last level reached by a sweep of one side (see sweep())
+    struct Sweep {
+        std::uint64_t qty = 0;
+        std::uint64_t notional = 0;
+        Price lastPrice = 0;
+    };
+
+    // Side-specialised kernels: S selects the ladder, touch, comparisons and scan direction
+    // at compile time; the public API dispatches on the runtime Side once.
+    static constexpr Side opposite(Side s) { return (s == Side::BUY) ? Side::SELL : Side::BUY; }
+    // Touch value of an empty side
+    template <Side S>
+    static constexpr Price emptyTouch() {
+        return (S == Side::BUY) ? 0 : MAX_PRICE;
+    }
+    template <Side S>
+    Ladder& ladderOf() {
+        if constexpr (S == Side::BUY)
+            return bids;
+        else
+            return asks;
+    }
+    template <Side S>
+    Price& touchOf() {
+        if constexpr (S == Side::BUY)
+            return highestBid;
+        else
+            return lowestAsk;
+    }
+    // Whether a side-S order at `price` would take liquidity (the opposite touch is at or through it)
+    template <Side S>
+    bool crossesTouch(Price price) {
+        constexpr Side M = opposite(S);
+        Price touch = touchOf<M>();
+        return touch != emptyTouch<M>() && ((S == Side::BUY) ? touch <= price : touch >= price);
+    }
+    template <Side S>
+    DepthCache<S>& depthOf() {
+        if constexpr (S == Side::BUY)
+            return bidDepth;
+        else
+            return askDepth;
+    }
+    template <Side S>
+    VolumeTree* volumeOf() const {
+        if constexpr (S == Side::BUY)
+            return bidVolume.get();
+        else
+            return askVolume.get();
+    }
+
+    template <Side S>
+    std::unique_ptr<Ladder>& stopsOf() {
+        if constexpr (S == Side::BUY)
+            return buyStops;
+        else
+            return sellStops;
+    }
+    template <Side S>
+    Price& stopTouchOf() {
+        if constexpr (S == Side::BUY)
+            return lowestBuyStop;
+        else
+            return highestSellStop;
+    }
+    static bool isPendingStop(const Order* order) {
+        return order->orderType == OrderType::STOP || order->orderType == OrderType::STOP_LIMIT;
+    }
+    // The last trade reached a pending trigger. Checked after every operation that can trade.
+    bool stopsTriggered() const {
+        return lastTradePrice >= lowestBuyStop || (lastTradePrice != 0 && lastTradePrice <= highestSellStop);
+    }
+    // Activates triggered stops one at a time until none is left: buy side first, best
+    // trigger first, FIFO within a trigger. Each activation may trade and trigger more,
+    // so a cascade is this loop re-checking, never a recursive call.
+    void releaseStops();
+    template <Side S>
+    bool addStop(OrderId id, Price stopPrice, Price limitPrice, Quantity qty, OrderType type);
+    // Detaches a pending stop from its trigger level (moving the side's next trigger if needed)
+    template <Side S>
+    void unlinkStop(Order* order);
+    // Takes the first stop at side S's next trigger and sends it in as a taker
+    template <Side S>
+    void activateStop();
+
+    // Slides side S's ladder window to `center` (and its volume tree with it)
+    template <Side S>
+    void recenter(Price center);
+    // Refills side S's volume tree from the levels in its ladder window
+    template <Side S>
+    void rebuildVolume();
+    // Takes up to `qty` from resting side S, best level first, stopping at levels worse
+    // than `limit`. Read-only: the volume tree answers for the window in O(log width),
+    // levels outside it (or every level, without the tree) are walked one by one.
+    template <Side S>
+    Sweep sweep(std::uint64_t qty, Price limit) const;
+
+    // Rescans for side S's touch after its best level emptied
+    template <Side S>
+    void updateBest();
+    void dispatch(const Command& cmd);
+    // process() with TSC timestamps around the dispatch
+    void processTimed(const Command& cmd);
+    // submitBatch() prefetch stages (read-only)
+    void prefetchSlots(const Command& cmd) const;
+    void prefetchEntries(const Command& cmd) const;
+    void prefetchLinks(const Command& cmd) const;
+    // Fills a side-S taker against the opposite side, up to `price`
+    template <Side S>
+    void matchOrder(OrderId takerId, Price price, Quantity& fillQty);
+    // Appends an order to the back of its price level (creating the level if needed)
+    template <Side S>
+    void restOrder(Order* order);
+    // Detaches an order from its price level (dropping the level if it empties)
+    template <Side S>
+    void unlinkOrder(Order* order);
+    // Unlinks, unindexes and frees a resting order
+    template <Side S>
+    void removeOrder(Order* order);
+    void removeOrder(Order* order) {
+        if (isPendingStop(order)) [[unlikely]] {
+            if (order->side == Side::BUY) {
+                unlinkStop<Side::BUY>(order);
+            } else {
+                unlinkStop<Side::SELL>(order);
+            }
+            orderMap.erase(order->orderId);
+            orderPool.release(order);
+            return;
+        }
+        if (order->side == Side::BUY) {
+            removeOrder<Side::BUY>(order);
+        } else {
+            removeOrder<Side::SELL>(order);
+        }
+    }
+    // modifyOrder() case B: unlink, match at the new price, rest any remainder
+    template <Side S>
+    void repriceOrder(Order* order, Price newPrice, Quantity newQty);
+    // Lowers a resting order's quantity in place (queue position kept)
+    void shrinkOrder(Order* order, Quantity newQty);
+    // Mirrors a changed level into the depth cache and volume tree (limit == nullptr: level was erased)
+    template <Side S>
+    void syncDepth(Price price, const Limit* limit) {
+        if (VolumeTree* tree = volumeOf<S>())
+            tree->set(price, limit ? limit->totalVolume : 0);
+        syncDepth(depthOf<S>(), ladderOf<S>(), price, limit);
+    }
+    void syncDepth(Side side, Price price, const Limit* limit) {
+        if (side == Side::BUY) {
+            syncDepth<Side::BUY>(price, limit);
+        } else {
+            syncDepth<Side::SELL>(price, limit);
+        }
+    }
+    template <Side S>
+    void syncDepth(DepthCache<S>& cache, const Ladder& ladder, Price price, const Limit* limit);
 
     friend class OrderBookTest;
 
 public:
-    Book(size_t maxOrders)
-        : bids(MAX_PRICE, nullptr)
-        , asks(MAX_PRICE, nullptr)
-        , bidsMask(MAX_PRICE)
-        , asksMask(MAX_PRICE)
-        , orderMap(maxOrders, nullptr)
+    BasicBook(size_t maxOrders, size_t ladderWidth = DEFAULT_LADDER_WIDTH, Listener l = Listener())
+        : bids(ladderWidth)
+        , asks(ladderWidth)
+        , orderMap(maxOrders)
         , orderPool(maxOrders)
-        , limitPool(MAX_PRICE) {}
-
-    ~Book();
+        , listener(std::move(l)) {}
 
-    void addLimitOrder(OrderId id, Price price, Quantity qty, Side side);
-    void addMarketOrder(OrderId id, Quantity qty, Side side);
+    void addLimitOrder(OrderId id, Price price, Quantity qty, Side side) {
+        if (side == Side::BUY) {
+            addLimitOrder<Side::BUY>(id, price, qty);
+        } else {
+            addLimitOrder<Side::SELL>(id, price, qty);
+        }
+    }
+    void addMarketOrder(OrderId id, Quantity qty, Side side) {
+        if (side == Side::BUY) {
+            addMarketOrder<Side::BUY>(id, qty);
+        } else {
+            addMarketOrder<Side::SELL>(id, qty);
+        }
+    }
+    // Immediate-or-cancel: matches up to `price`, drops whatever is left (never rests)
+    void addIocOrder(OrderId id, Price price, Quantity qty, Side side) {
+        if (side == Side::BUY) {
+            addIocOrder<Side::BUY>(id, price, qty);
+        } else {
+            addIocOrder<Side::SELL>(id, price, qty);
+        }
+    }
+    // Fill-or-kill: fills all of `qty` up to `price`, or does nothing. The liquidity check
+    // is a read-only sweep (O(log window) with the volume index), so a killed order leaves
+    // no trace. Returns false if killed.
+    bool addFokOrder(OrderId id, Price price, Quantity qty, Side side) {
+        return (side == Side::BUY) ? addFokOrder<Side::BUY>(id, price, qty) : addFokOrder<Side::SELL>(id, price, qty);
+    }
+    // Post-only: rests without matching, or is rejected (returns false) if it would cross
+    bool addPostOnlyOrder(OrderId id, Price price, Quantity qty, Side side) {
+        return (side == Side::BUY) ? addPostOnlyOrder<Side::BUY>(id, price, qty)
+                                   : addPostOnlyOrder<Side::SELL>(id, price, qty);
+    }
+    // Stop: held off the book until a trade prints at or through `stopPrice` (at or above
+    // for buys, at or below for sells), then sent in as a market order. A stop whose
+    // trigger the last trade already reached fires straight away. Until it fires only
+    // cancelOrder() acts on it (modify / reduce / replace leave it alone).
+    // Returns false (nothing added) for a zero quantity or a stopPrice of 0 or MAX_PRICE.
+    bool addStopOrder(OrderId id, Price stopPrice, Quantity qty, Side side) {
+        return (side == Side::BUY) ? addStop<Side::BUY>(id, stopPrice, 0, qty, OrderType::STOP)
+                                   : addStop<Side::SELL>(id, stopPrice, 0, qty, OrderType::STOP);
+    }
+    // Stop-limit: as above, but sent in as a limit order at `limitPrice`
+    bool addStopLimitOrder(OrderId id, Price stopPrice, Price limitPrice, Quantity qty, Side side) {
+        return (side == Side::BUY) ? addStop<Side::BUY>(id, stopPrice, limitPrice, qty, OrderType::STOP_LIMIT)
+                                   : addStop<Side::SELL>(id, stopPrice, limitPrice, qty, OrderType::STOP_LIMIT);
+    }
+    // Rests a limit order at `price` without matching, even if it locks or crosses the
+    // book. For rebuilding a book from an exchange feed, where adds are already-resting
+    // orders whose fills arrive later as their own messages.
+    void restLimitOrder(OrderId id, Price price, Quantity qty, Side side) {
+        if (side == Side::BUY) {
+            restLimitOrder<Side::BUY>(id, price, qty);
+        } else {
+            restLimitOrder<Side::SELL>(id, price, qty);
+        }
+    }
+    // Same, for callers that know the side at compile time (no runtime dispatch)
+    template <Side S>
+    void addLimitOrder(OrderId id, Price price, Quantity qty);
+    template <Side S>
+    void restLimitOrder(OrderId id, Price price, Quantity qty);
+    template <Side S>
+    void addMarketOrder(OrderId id, Quantity qty);
+    template <Side S>
+    void addIocOrder(OrderId id, Price price, Quantity qty) {
+        matchOrder<S>(id, price, qty);
+        if (stopsTriggered()) [[unlikely]]
+            releaseStops();
+    }
+    template <Side S>
+    bool addFokOrder(OrderId id, Price price, Quantity qty);
+    template <Side S>
+    bool addPostOnlyOrder(OrderId id, Price price, Quantity qty);
     void cancelOrder(OrderId id);
+    // Quantity reduction at the same price keeps queue position; any other change
+    // re-prices the order (matching immediately if it now crosses) and sends it to the back.
+    // A post-only order is never re-priced through the spread: that modify is ignored and
+    // the order keeps its price, quantity and queue position.
+    void modifyOrder(OrderId id, Price newPrice, Quantity newQty);
+    // Takes `qty` off a resting order (partial cancel / external execution), keeping its
+    // queue position; removes the order once nothing is left
+    void reduceOrder(OrderId id, Quantity qty);
+    // Replaces a resting order with a new ID, price and quantity on the same side
+    // (priority is lost, as with a cancel + add)
+    void replaceOrder(OrderId oldId, OrderId newId, Price newPrice, Quantity newQty);
+    // replaceOrder() for feed rebuilds: the new order rests without matching (see restLimitOrder)
+    void restReplaceOrder(OrderId oldId, OrderId newId, Price newPrice, Quantity newQty);
+
+    // Dispatches a fixed-size command record to the matching operation
+    void process(const Command& cmd) {
+        if (latencyStats) [[unlikely]] {
+            processTimed(cmd);
+            return;
+        }
+        dispatch(cmd);
+    }
+
+    // Processes `cmds` in order, exactly as process() on each one would, while prefetching
+    // the index slots, orders and levels the next few commands will touch. A cancel's
+    // chain of dependent misses (index slot -> Order -> Limit / neighbours) then overlaps
+    // with the work on the commands before it.
+    void submitBatch(std::span<const Command> cmds);
+
+    // Times every process() call into per-operation histograms (see LatencyHistogram.h).
+    // Off, the cost is one predictable branch per command; on, two TSC reads.
+    // Turning it off discards the histograms.
+    void enableLatencyStats(bool enabled) {
+        if (!enabled) {
+            latencyStats.reset();
+        } else if (!latencyStats) {
+            latencyStats = std::make_unique<OperationLatency>();
+        }
+    }
+    // nullptr while disabled; readable from another thread while enabled
+    const OperationLatency* getLatencyStats() const { return latencyStats.get(); }
+
+    // Keeps a Fenwick tree of resting volume per side (see VolumeTree.h), so the
+    // liquidity queries below cost O(log window) instead of one step per level.
+    // Off, they walk the levels and the book pays nothing; on, every level change also
+    // updates log2(window) tree nodes, and each window slide rebuilds the tree.
+    void enableVolumeIndex(bool enabled) {
+        if (!enabled) {
+            bidVolume.reset();
+            askVolume.reset();
+        } else if (!bidVolume) {
+            bidVolume = std::make_unique<VolumeTree>(bids.getWidth());
+            askVolume = std::make_unique<VolumeTree>(asks.getWidth());
+            rebuildVolume<Side::BUY>();
+            rebuildVolume<Side::SELL>();
+        }
+    }
+
+    // Quantity resting on `side` from the touch through `price` (inclusive)
+    std::uint64_t getVolumeThrough(Side side, Price price) const {
+        constexpr std::uint64_t ALL = std::numeric_limits<std::uint64_t>::max();
+        return (side == Side::BUY) ? sweep<Side::BUY>(ALL, price).qty : sweep<Side::SELL>(ALL, price).qty;
+    }
+    // Price of the last level a market order for `qty` against `side` would reach,
+    // or nullopt if `side` holds less than `qty`
+    std::optional<Price> getSweepPrice(Side side, std::uint64_t qty) const {
+        Sweep s = (side == Side::BUY) ? sweep<Side::BUY>(qty, 0) : sweep<Side::SELL>(qty, MAX_PRICE);
+        return (qty > 0 && s.qty == qty) ? std::optional<Price>(s.lastPrice) : std::nullopt;
+    }
+    // Volume-weighted average price of taking `qty` from `side`, or nullopt if `side`
+    // holds less than `qty`
+    std::optional<double> getFillVwap(Side side, std::uint64_t qty) const {
+        Sweep s = (side == Side::BUY) ? sweep<Side::BUY>(qty, 0) : sweep<Side::SELL>(qty, MAX_PRICE);
+        return (qty > 0 && s.qty == qty) ? std::optional<double>(static_cast<double>(s.notional) / qty) : std::nullopt;
+    }
+
+    // Drops every order and level (pools are recycled wholesale, not released one by one)
+    void clear();
+
+    // Writes every resting order, level by level in FIFO order, plus the touch, every pending
+    // stop and the last trade price (see Snapshot.h).
+    void saveSnapshot(const std::string& path) const;
+    // Replaces the book's contents with a snapshot in one linear pass over the mapped file:
+    // levels, queues and index entries are built directly, without matching.
+    // Throws std::runtime_error (leaving the book empty) if the file is malformed.
+    void loadSnapshot(const std::string& path);
+
+    // Copies up to `n` levels of one side (best first) into `out`; returns the count written
+    size_t getDepth(Side side, DepthLevel* out, size_t n) const {
+        const DepthLevel* levels = (side == Side::BUY) ? bidDepth.data() : askDepth.data();
+        size_t count = std::min(n, (side == Side::BUY) ? bidDepth.size() : askDepth.size());
+        std::copy_n(levels, count, out);
+        return count;
+    }
+
+    std::optional<Price> getLastTradePrice() const {
+        return lastTradePrice ? std::optional<Price>(lastTradePrice) : std::nullopt;
+    }
+    std::optional<Price> getBestBid() const { return bids.empty() ? std::nullopt : std::optional<Price>(highestBid); }
+    std::optional<Price> getBestAsk() const { return asks.empty() ? std::nullopt : std::optional<Price>(lowestAsk); }
+    // Ask minus bid, when both sides are populated
+    std::optional<Price> getSpread() const {
+        if (bids.empty() || asks.empty())
+            return std::nullopt;
+        return lowestAsk - highestBid;
+    }
+
+    Listener& getListener() { return listener; }
 
-    // For Benchmarking
-    void setTradeCallback(const TradeCallback& cb) { tradeListener = cb; }
+    // Occupancy / high-water statistics
+    const ObjectPool<Order>& getOrderPool() const { return orderPool; }
+
+    // Runtime callback (type-erased adapter only)
+    void setTradeCallback(const TradeCallback& cb)
+        requires std::is_same_v<Listener, CallbackListener>
+    {
+        listener = CallbackListener(cb);
+    }
 };
 
+using Book = BasicBook<CallbackListener>;
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::updateBest() {
+    Ladder& ladder = ladderOf<S>();
+    Price& touch = touchOf<S>();
+
+    long long next = (S == Side::BUY) ? ladder.scanDesc(touch) : ladder.scanAsc(touch);
+    touch = (next == -1) ? emptyTouch<S>() : static_cast<Price>(next);
+
+    // Touch drifted out of the dense window: slide it over
+    if (next != -1 && !ladder.inWindow(touch)) {
+        recenter<S>(touch);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::recenter(Price center) {
+    Ladder& ladder = ladderOf<S>();
+    Price oldBase = ladder.getBase();
+    ladder.recenter(center);
+
+    if (volumeOf<S>() && ladder.getBase() != oldBase)
+        rebuildVolume<S>();
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::rebuildVolume() {
+    const Ladder& ladder = ladderOf<S>();
+    VolumeTree* tree = volumeOf<S>();
+
+    tree->reset(ladder.getBase());
+    for (long long p = ladder.scanAsc(ladder.getBase()); p != -1 && ladder.inWindow(p); p = ladder.scanAsc(p + 1)) {
+        tree->load(p, ladder.find(p)->totalVolume);
+    }
+    tree->build();
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+typename BasicBook<Listener, Index, Ladder>::Sweep BasicBook<Listener, Index, Ladder>::sweep(std::uint64_t qty,
+                                                                                              Price limit) const {
+    const Ladder& ladder = (S == Side::BUY) ? bids : asks;
+    const Price touch = (S == Side::BUY) ? highestBid : lowestAsk;
+
+    Sweep out;
+    if (qty == 0 || ladder.empty() || ((S == Side::BUY) ? touch < limit : touch > limit))
+        return out;
+
+    // Where the level-by-level walk starts
+    long long next = touch;
+
+    // The touch is always inside the window, so the tree covers the best levels
+    if (const VolumeTree* tree = volumeOf<S>()) {
+        const std::uint64_t base = tree->getBase();
+        const size_t width = tree->getWidth();
+
+        if constexpr (S == Side::SELL) {
+            // Window prices up to the limit: offsets [0, n)
+            size_t n = std::min<std::uint64_t>(std::uint64_t(limit) - base + 1, width);
+            VolumeTree::Sum avail = tree->prefix(n);
+
+            if (avail.volume >= qty) {
+                // Offset k is where the cumulative volume reaches qty
+                size_t k = tree->upperBound(qty - 1);
+                VolumeTree::Sum before = tree->prefix(k);
+                return {qty, base * qty + before.notional + k * (qty - before.volume), static_cast<Price>(base + k)};
+            }
+
+            out = {avail.volume, base * avail.volume + avail.notional, 0};
+            if (n < width)
+                return out;
+            next = base + width;
+        } else {
+            // Window prices down to the limit: offsets [m, width)
+            size_t m = (limit <= base) ? 0 : limit - base;
+            VolumeTree::Sum total = tree->total();
+            VolumeTree::Sum below = tree->prefix(m);
+
+            if (total.volume - below.volume >= qty) {
+                // Offset k is where the cumulative volume from the top reaches qty
+                size_t k = tree->upperBound(total.volume - qty);
+                VolumeTree::Sum through = tree->prefix(k + 1);
+                std::uint64_t above = total.volume - through.volume;
+                return {qty, base * qty + (total.notional - through.notional) + k * (qty - above),
+                        static_cast<Price>(base + k)};
+            }
+
+            std::uint64_t avail = total.volume - below.volume;
+            out = {avail, base * avail + total.notional - below.notional, 0};
+            if (limit >= base)
+                return out;
+            next = base - 1;
+        }
+    }
+
+    for (long long p = (S == Side::BUY) ? ladder.scanDesc(next) : ladder.scanAsc(next); p != -1 && out.qty < qty;) {
+        if ((S == Side::BUY) ? p < limit : p > limit)
+            break;
+
+        std::uint64_t take = std::min<std::uint64_t>(ladder.find(p)->totalVolume, qty - out.qty);
+        out.qty += take;
+        out.notional += take * p;
+        out.lastPrice = static_cast<Price>(p);
+
+        if constexpr (S == Side::BUY) {
+            p = (p > 0) ? ladder.scanDesc(p - 1) : -1;
+        } else {
+            p = ladder.scanAsc(p + 1);
+        }
+    }
+    return out;
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::matchOrder(OrderId takerId, Price price, Quantity& fillQty) {
+    // Resting side being matched against, fixed at compile time
+    constexpr Side M = opposite(S);
+    Ladder& opposingBook = ladderOf<M>();
+    Price& bestPrice = touchOf<M>();
+
+    while (fillQty > 0) {
+        // Check if book is empty or the touch is no longer profitable
+        if (bestPrice == emptyTouch<M>())
+            break;
+        if ((S == Side::BUY) ? bestPrice > price : bestPrice < price)
+            break;
+
+        Limit* bestLimit = opposingBook.find(bestPrice);
+        // No orders at the limit
+        if (bestLimit == nullptr) {
+            updateBest<M>();
+            continue;
+        }
+
+        // Iterate through Limit Queue
+        while (fillQty > 0 && bestLimit->size > 0) {
+            Order* headOrder = bestLimit->head;
+
+            // Direct call on the concrete listener (inlined; NoopListener compiles away)
+            Quantity tradeQty = std::min(fillQty, headOrder->qty);
+            listener.onTrade({
+                takerId,
+                headOrder->orderId,
+                bestLimit->limitPrice,
+                tradeQty,
+                headOrder->qty - tradeQty,
+                headOrder->qty == tradeQty && bestLimit->size == 1,
+            });
+
+            if (headOrder->qty > fillQty) {
+                // Case A: (Full Fill of Taker's Order)
+                headOrder->fill(fillQty);
+                bestLimit->totalVolume -= fillQty;
+                fillQty = 0;
+            }
+
+            else {
+                // Case B: (Partial Fill of Taker's Order)
+                fillQty -= headOrder->qty;
+                // Remove from Order Map
+                orderMap.erase(headOrder->orderId);
+                // Remove from Limit Queue (takes its volume with it)
+                bestLimit->removeOrder(headOrder);
+                // Fully Fill Maker's Order
+                headOrder->fill(headOrder->qty);
+                orderPool.release(headOrder);
+            }
+        }
+
+        lastTradePrice = bestLimit->limitPrice;
+
+        // Remove Limit When Empty
+        if (bestLimit->size == 0) {
+            Price emptied = bestPrice;
+            opposingBook.erase(emptied);
+            syncDepth<M>(emptied, nullptr);
+            updateBest<M>();
+        } else {
+            syncDepth<M>(bestLimit->limitPrice, bestLimit);
+        }
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::addLimitOrder(OrderId id, Price price, Quantity qty) {
+    matchOrder<S>(id, price, qty);
+
+    // If there are still shares to fill, create a new order
+    if (qty > 0) {
+        // Create new order and add to Order Lookup Map
+        Order* newOrder = orderPool.acquire(id, price, qty, OrderType::LIMIT, S);
+        orderMap.insert(id, newOrder);
+
+        restOrder<S>(newOrder);
+    }
+
+    if (stopsTriggered()) [[unlikely]]
+        releaseStops();
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::restLimitOrder(OrderId id, Price price, Quantity qty) {
+    if (qty == 0)
+        return;
+
+    Order* newOrder = orderPool.acquire(id, price, qty, OrderType::LIMIT, S);
+    orderMap.insert(id, newOrder);
+    restOrder<S>(newOrder);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::restOrder(Order* order) {
+    Price price = order->price;
+
+    // Get respective book
+    Ladder& book = ladderOf<S>();
+
+    // Get Limit or create one if it doesn't exist
+    Limit* limit = book.find(price);
+
+    if (!limit) {
+        Price& touch = touchOf<S>();
+        bool improvesTouch = book.empty() || ((S == Side::BUY) ? price > touch : price < touch);
+
+        // New touch outside the dense window: slide the window to it
+        if (improvesTouch && !book.inWindow(price)) {
+            recenter<S>(price);
+        }
+
+        limit = book.insert(price);
+
+        if (improvesTouch) {
+            touch = price;
+        }
+    }
+    // Add the Order to the back of the Limit queue
+    limit->addOrder(order);
+    syncDepth<S>(price, limit);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::addMarketOrder(OrderId id, Quantity qty) {
+    if constexpr (S == Side::BUY) {
+        matchOrder<S>(id, std::numeric_limits<Price>::max(), qty);
+    } else {
+        matchOrder<S>(id, std::numeric_limits<Price>::min(), qty);
+    }
+
+    if (stopsTriggered()) [[unlikely]]
+        releaseStops();
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+bool BasicBook<Listener, Index, Ladder>::addFokOrder(OrderId id, Price price, Quantity qty) {
+    if (qty == 0 || sweep<opposite(S)>(qty, price).qty < qty)
+        return false;
+
+    matchOrder<S>(id, price, qty);
+    if (stopsTriggered()) [[unlikely]]
+        releaseStops();
+    return true;
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+bool BasicBook<Listener, Index, Ladder>::addPostOnlyOrder(OrderId id, Price price, Quantity qty) {
+    if (qty == 0 || crossesTouch<S>(price))
+        return false;
+
+    Order* newOrder = orderPool.acquire(id, price, qty, OrderType::POST_ONLY, S);
+    orderMap.insert(id, newOrder);
+    restOrder<S>(newOrder);
+    return true;
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+bool BasicBook<Listener, Index, Ladder>::addStop(OrderId id, Price stopPrice, Price limitPrice, Quantity qty,
+                                                 OrderType type) {
+    if (qty == 0 || stopPrice == 0 || stopPrice >= MAX_PRICE)
+        return false;
+
+    std::unique_ptr<Ladder>& stops = stopsOf<S>();
+    if (!stops)
+        stops = std::make_unique<Ladder>(bids.getWidth());
+
+    Order* order = orderPool.acquire(id, limitPrice, qty, type, S);
+    orderMap.insert(id, order);
+
+    Limit* level = stops->find(stopPrice);
+    if (!level) {
+        // Buy stops are ranked like asks (lowest trigger first), sell stops like bids
+        Price& next = stopTouchOf<S>();
+        bool improvesNext = stops->empty() || ((S == Side::BUY) ? stopPrice < next : stopPrice > next);
+        if (improvesNext && !stops->inWindow(stopPrice)) {
+            stops->recenter(stopPrice);
+        }
+
+        level = stops->insert(stopPrice);
+
+        if (improvesNext) {
+            next = stopPrice;
+        }
+    }
+    level->addOrder(order);
+
+    if (stopsTriggered())
+        releaseStops();
+    return true;
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::unlinkStop(Order* order) {
+    Ladder& stops = *stopsOf<S>();
+    Limit* level = order->parentLimit;
+    Price trigger = level->limitPrice;
+    level->removeOrder(order);
+
+    if (level->size > 0)
+        return;
+
+    stops.erase(trigger);
+    Price& next = stopTouchOf<S>();
+    if (trigger != next)
+        return;
+
+    long long scan = (S == Side::BUY) ? stops.scanAsc(trigger) : stops.scanDesc(trigger);
+    next = (scan == -1) ? ((S == Side::BUY) ? MAX_PRICE : 0) : static_cast<Price>(scan);
+    if (scan != -1 && !stops.inWindow(next)) {
+        stops.recenter(next);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::activateStop() {
+    Order* order = stopsOf<S>()->find(stopTouchOf<S>())->head;
+    unlinkStop<S>(order);
+
+    Quantity qty = order->qty;
+    if (order->orderType == OrderType::STOP_LIMIT) {
+        matchOrder<S>(order->orderId, order->price, qty);
+    } else if constexpr (S == Side::BUY) {
+        matchOrder<S>(order->orderId, std::numeric_limits<Price>::max(), qty);
+    } else {
+        matchOrder<S>(order->orderId, std::numeric_limits<Price>::min(), qty);
+    }
+
+    // A stop-limit remainder rests as an ordinary limit order (same Order and index entry)
+    if (qty > 0 && order->orderType == OrderType::STOP_LIMIT) {
+        order->qty = qty;
+        order->orderType = OrderType::LIMIT;
+        restOrder<S>(order);
+    } else {
+        orderMap.erase(order->orderId);
+        orderPool.release(order);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::releaseStops() {
+    while (true) {
+        if (lastTradePrice >= lowestBuyStop) {
+            activateStop<Side::BUY>();
+        } else if (lastTradePrice != 0 && lastTradePrice <= highestSellStop) {
+            activateStop<Side::SELL>();
+        } else {
+            break;
+        }
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::cancelOrder(OrderId id) {
+    // Check if order actually exists
+    Order* order = orderMap.find(id);
+    if (order == nullptr)
+        return;
+
+    removeOrder(order);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::removeOrder(Order* order) {
+    unlinkOrder<S>(order);
+
+    orderMap.erase(order->orderId);
+    orderPool.release(order);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::shrinkOrder(Order* order, Quantity newQty) {
+    order->parentLimit->totalVolume -= order->qty - newQty;
+    order->qty = newQty;
+    syncDepth(order->side, order->price, order->parentLimit);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::unlinkOrder(Order* order) {
+    Limit* parentLimit = order->parentLimit;
+    parentLimit->removeOrder(order);
+
+    Price p = parentLimit->limitPrice;
+
+    if (parentLimit->size == 0) {
+        ladderOf<S>().erase(p);
+        syncDepth<S>(p, nullptr);
+        if (p == touchOf<S>()) {
+            updateBest<S>();
+        }
+    } else {
+        syncDepth<S>(p, parentLimit);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::syncDepth(DepthCache<S>& cache, const Ladder& ladder, Price price, const Limit* limit) {
+    bool refill = limit ? cache.update(price, limit->totalVolume, limit->size) : cache.update(price, 0, 0);
+    if (!refill)
+        return;
+
+    // A full cache lost a level: pull in the next one past its (new) tail, if any
+    Price tail = cache.back().price;
+    long long next = (S == Side::BUY) ? (tail > 0 ? ladder.scanDesc(tail - 1) : -1) : ladder.scanAsc(tail + 1);
+
+    if (next != -1) {
+        const Limit* level = ladder.find(static_cast<Price>(next));
+        cache.append({level->limitPrice, level->totalVolume, level->size});
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::modifyOrder(OrderId id, Price newPrice, Quantity newQty) {
+    Order* order = orderMap.find(id);
+    if (order == nullptr || isPendingStop(order))
+        return;
+
+    if (newQty == 0) {
+        removeOrder(order);
+        return;
+    }
+
+    // Case A: Size-down at the same price: in place, queue position kept
+    if (newPrice == order->price && newQty <= order->qty) {
+        shrinkOrder(order, newQty);
+        return;
+    }
+
+    // Case B: Replace (post-only must still not take liquidity at its new price)
+    if (order->side == Side::BUY) {
+        if (order->orderType == OrderType::POST_ONLY && crossesTouch<Side::BUY>(newPrice))
+            return;
+        repriceOrder<Side::BUY>(order, newPrice, newQty);
+    } else {
+        if (order->orderType == OrderType::POST_ONLY && crossesTouch<Side::SELL>(newPrice))
+            return;
+        repriceOrder<Side::SELL>(order, newPrice, newQty);
+    }
+
+    if (stopsTriggered()) [[unlikely]]
+        releaseStops();
+}
+
+template <typename Listener, typename Index, typename Ladder>
+template <Side S>
+void BasicBook<Listener, Index, Ladder>::repriceOrder(Order* order, Price newPrice, Quantity newQty) {
+    // Leave the level, then behave like a fresh limit order while reusing the same
+    // Order object and index entry
+    unlinkOrder<S>(order);
+
+    Quantity remaining = newQty;
+    matchOrder<S>(order->orderId, newPrice, remaining);
+
+    if (remaining > 0) {
+        order->price = newPrice;
+        order->qty = remaining;
+        restOrder<S>(order);
+    } else {
+        orderMap.erase(order->orderId);
+        orderPool.release(order);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::reduceOrder(OrderId id, Quantity qty) {
+    Order* order = orderMap.find(id);
+    if (order == nullptr || isPendingStop(order))
+        return;
+
+    if (qty >= order->qty) {
+        removeOrder(order);
+    } else {
+        shrinkOrder(order, order->qty - qty);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::replaceOrder(OrderId oldId, OrderId newId, Price newPrice, Quantity newQty) {
+    Order* order = orderMap.find(oldId);
+    if (order == nullptr || isPendingStop(order))
+        return;
+
+    Side side = order->side;
+    removeOrder(order);
+
+    if (newQty > 0) {
+        addLimitOrder(newId, newPrice, newQty, side);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::restReplaceOrder(OrderId oldId, OrderId newId, Price newPrice, Quantity newQty) {
+    Order* order = orderMap.find(oldId);
+    if (order == nullptr || isPendingStop(order))
+        return;
+
+    Side side = order->side;
+    removeOrder(order);
+    restLimitOrder(newId, newPrice, newQty, side);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::dispatch(const Command& cmd) {
+    switch (cmd.type) {
+    case OrderType::LIMIT:
+        addLimitOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+        break;
+    case OrderType::CANCEL:
+        cancelOrder(cmd.id);
+        break;
+    case OrderType::MARKET:
+        addMarketOrder(cmd.id, cmd.qty, cmd.side);
+        break;
+    case OrderType::MODIFY:
+        modifyOrder(cmd.id, cmd.price, cmd.qty);
+        break;
+    case OrderType::IOC:
+        addIocOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+        break;
+    case OrderType::FOK:
+        addFokOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+        break;
+    case OrderType::POST_ONLY:
+        addPostOnlyOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+        break;
+    case OrderType::STOP:
+        addStopOrder(cmd.id, cmd.stopPrice, cmd.qty, cmd.side);
+        break;
+    case OrderType::STOP_LIMIT:
+        addStopLimitOrder(cmd.id, cmd.stopPrice, cmd.price, cmd.qty, cmd.side);
+        break;
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::submitBatch(std::span<const Command> cmds) {
+    const size_t n = cmds.size();
+
+    for (size_t i = 0; i < n; i++) {
+        if (i + BATCH_PREFETCH_SLOT < n)
+            prefetchSlots(cmds[i + BATCH_PREFETCH_SLOT]);
+        if (i + BATCH_PREFETCH_ENTRY < n)
+            prefetchEntries(cmds[i + BATCH_PREFETCH_ENTRY]);
+        if (i + BATCH_PREFETCH_LINKS < n)
+            prefetchLinks(cmds[i + BATCH_PREFETCH_LINKS]);
+
+        process(cmds[i]);
+    }
+}
+
+// The stages below re-read the book as it is now (no pointer is carried between stages or
+// into processing), so an order filled or cancelled in the meantime just wastes a hint.
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::prefetchSlots(const Command& cmd) const {
+    switch (cmd.type) {
+    case OrderType::LIMIT:
+    case OrderType::POST_ONLY:
+        // Index slot the new order will be inserted into, and the level it would rest on
+        orderMap.prefetch(cmd.id);
+        ((cmd.side == Side::BUY) ? bids : asks).prefetch(cmd.price);
+        break;
+    case OrderType::CANCEL:
+    case OrderType::MODIFY:
+    case OrderType::STOP:
+    case OrderType::STOP_LIMIT:
+        orderMap.prefetch(cmd.id);
+        break;
+    case OrderType::MARKET:
+    case OrderType::IOC:
+    case OrderType::FOK:
+        // Only touches the top of the book, which is already hot
+        break;
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::prefetchEntries(const Command& cmd) const {
+    if (cmd.type == OrderType::LIMIT || cmd.type == OrderType::POST_ONLY) {
+        if (const Limit* limit = ((cmd.side == Side::BUY) ? bids : asks).peek(cmd.price))
+            __builtin_prefetch(limit, 1);
+    } else if (cmd.type == OrderType::CANCEL || cmd.type == OrderType::MODIFY) {
+        if (const Order* order = orderMap.find(cmd.id))
+            __builtin_prefetch(order, 1);
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::prefetchLinks(const Command& cmd) const {
+    if (cmd.type == OrderType::LIMIT || cmd.type == OrderType::POST_ONLY) {
+        // Resting appends behind the level's tail
+        const Limit* limit = ((cmd.side == Side::BUY) ? bids : asks).peek(cmd.price);
+        if (limit && limit->tail)
+            __builtin_prefetch(limit->tail, 1);
+    } else if (cmd.type == OrderType::CANCEL || cmd.type == OrderType::MODIFY) {
+        // Unlinking writes the level and both neighbours
+        if (const Order* order = orderMap.find(cmd.id)) {
+            __builtin_prefetch(order->parentLimit, 1);
+            if (order->prevOrder)
+                __builtin_prefetch(order->prevOrder, 1);
+            if (order->nextOrder)
+                __builtin_prefetch(order->nextOrder, 1);
+        }
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::processTimed(const Command& cmd) {
+    LatencyOp op = LatencyOp::MODIFY;
+    switch (cmd.type) {
+    case OrderType::LIMIT: {
+        bool crosses = (cmd.side == Side::BUY) ? (!asks.empty() && cmd.price >= lowestAsk)
+                                               : (!bids.empty() && cmd.price <= highestBid);
+        op = crosses ? LatencyOp::LIMIT_MATCH : LatencyOp::LIMIT_REST;
+        break;
+    }
+    case OrderType::CANCEL:
+        op = LatencyOp::CANCEL;
+        break;
+    case OrderType::MARKET:
+        op = LatencyOp::MARKET;
+        break;
+    case OrderType::MODIFY:
+        break;
+    case OrderType::IOC:
+    case OrderType::FOK:
+        op = LatencyOp::IMMEDIATE;
+        break;
+    case OrderType::POST_ONLY:
+    case OrderType::STOP:
+    case OrderType::STOP_LIMIT:
+        op = LatencyOp::LIMIT_REST;
+        break;
+    }
+
+    std::uint64_t start = tscStart();
+    dispatch(cmd);
+    std::uint64_t end = tscStop();
+
+    (*latencyStats)[op].record(end - start);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::clear() {
+    lastTradePrice = 0;
+
+    // Nothing resting or pending: skip sweeping the (possibly huge) index and pool
+    if (orderPool.getInUse() == 0 && bids.empty() && asks.empty())
+        return;
+
+    if (buyStops)
+        buyStops->clear();
+    if (sellStops)
+        sellStops->clear();
+    lowestBuyStop = MAX_PRICE;
+    highestSellStop = 0;
+
+    bids.clear();
+    asks.clear();
+    orderMap.clear();
+    orderPool.reset();
+    bidDepth.clear();
+    askDepth.clear();
+    highestBid = 0;
+    lowestAsk = MAX_PRICE;
+
+    if (bidVolume) {
+        rebuildVolume<Side::BUY>();
+        rebuildVolume<Side::SELL>();
+    }
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::saveSnapshot(const std::string& path) const {
+    SnapshotWriter out(path);
+
+    // Queues are walked SNAPSHOT_LANES levels at a time, round-robin, so the cache misses
+    // of independent linked lists overlap instead of being taken one after another
+    std::array<const Limit*, SNAPSHOT_LANES> batch;
+    size_t batchSize = 0;
+    std::vector<SnapshotOrder> staged;
+
+    auto flushBatch = [&](Side side) {
+        std::array<const Order*, SNAPSHOT_LANES> cursor;
+        std::array<size_t, SNAPSHOT_LANES> slot;
+        size_t total = 0;
+        for (size_t i = 0; i < batchSize; i++) {
+            cursor[i] = batch[i]->head;
+            slot[i] = total;
+            total += batch[i]->size;
+        }
+        staged.resize(total);
+
+        for (bool active = true; active;) {
+            active = false;
+            for (size_t i = 0; i < batchSize; i++) {
+                if (const Order* order = cursor[i]) {
+                    staged[slot[i]++] = {order->orderId, order->qty, 0};
+                    cursor[i] = order->nextOrder;
+                    active = true;
+                }
+            }
+        }
+
+        const SnapshotOrder* orders = staged.data();
+        for (size_t i = 0; i < batchSize; i++) {
+            out.writeLevel(side, batch[i]->limitPrice, orders, batch[i]->size);
+            orders += batch[i]->size;
+        }
+        batchSize = 0;
+    };
+
+    auto writeSide = [&](const Ladder& ladder, Side side) {
+        ladder.forEachLevel([&](const Limit* limit) {
+            batch[batchSize++] = limit;
+            if (batchSize == SNAPSHOT_LANES)
+                flushBatch(side);
+        });
+        flushBatch(side);
+    };
+
+    writeSide(bids, Side::BUY);
+    writeSide(asks, Side::SELL);
+
+    // Pending stops: few and cold, so a plain walk of each trigger queue
+    std::vector<SnapshotStop> stops;
+    auto writeStops = [&](const std::unique_ptr<Ladder>& ladder, Side side) {
+        if (!ladder)
+            return;
+        ladder->forEachLevel([&](const Limit* level) {
+            stops.clear();
+            for (const Order* order = level->head; order != nullptr; order = order->nextOrder) {
+                stops.push_back({order->orderId, order->qty, order->price, order->orderType, {}});
+            }
+            out.writeStopLevel(side, level->limitPrice, stops.data(), static_cast<std::uint32_t>(stops.size()));
+        });
+    };
+    writeStops(buyStops, Side::BUY);
+    writeStops(sellStops, Side::SELL);
+
+    out.close(highestBid, lowestAsk, lastTradePrice);
+}
+
+template <typename Listener, typename Index, typename Ladder>
+void BasicBook<Listener, Index, Ladder>::loadSnapshot(const std::string& path) {
+    MappedFile file(path);
+    const std::uint8_t* pos = file.data();
+    const std::uint8_t* end = file.data() + file.size();
+
+    auto corrupt = [&]() {
+        clear();
+        return std::runtime_error("corrupt snapshot: " + path);
+    };
+
+    SnapshotHeader header;
+    if (file.size() < sizeof(header))
+        throw corrupt();
+    std::memcpy(&header, pos, sizeof(header));
+    pos += sizeof(header);
+
+    std::uint64_t levelCount = std::uint64_t(header.bidLevels) + header.askLevels;
+    std::uint64_t stopLevelCount = std::uint64_t(header.buyStopLevels) + header.sellStopLevels;
+    std::uint64_t body = file.size() - sizeof(header);
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION ||
+        header.orderCount > body / sizeof(SnapshotOrder) || header.stopCount > body / sizeof(SnapshotStop) ||
+        header.lastTradePrice >= MAX_PRICE ||
+        (levelCount + stopLevelCount) * sizeof(SnapshotLevel) + header.orderCount * sizeof(SnapshotOrder) +
+                header.stopCount * sizeof(SnapshotStop) !=
+            body) {
+        throw corrupt();
+    }
+
+    // Size everything once and put each window on its touch, so the pass below never
+    // grows a pool, rehashes the index or slides a window
+    clear();
+    orderPool.reserve(header.orderCount + header.stopCount);
+    orderMap.reserve(header.orderCount + header.stopCount);
+    if (header.bidLevels > 0)
+        recenter<Side::BUY>(header.highestBid);
+    if (header.askLevels > 0)
+        recenter<Side::SELL>(header.lowestAsk);
+
+    Price bestBid = 0;
+    Price bestAsk = MAX_PRICE;
+    // Orders claimed by the levels read so far; may never pass header.orderCount
+    std::uint64_t loaded = 0;
+
+    for (std::uint64_t l = 0; l < levelCount; l++) {
+        Side side = (l < header.bidLevels) ? Side::BUY : Side::SELL;
+        Ladder& ladder = (side == Side::BUY) ? bids : asks;
+
+        // Level counts are untrusted: bound every read by what is left of the mapping
+        if (static_cast<std::uint64_t>(end - pos) < sizeof(SnapshotLevel))
+            throw corrupt();
+        SnapshotLevel level;
+        std::memcpy(&level, pos, sizeof(level));
+        pos += sizeof(level);
+
+        loaded += level.orderCount;
+        if (level.orderCount == 0 || loaded > header.orderCount || level.price >= MAX_PRICE ||
+            ladder.find(level.price) != nullptr ||
+            static_cast<std::uint64_t>(end - pos) < std::uint64_t(level.orderCount) * sizeof(SnapshotOrder)) {
+            throw corrupt();
+        }
+
+        // Records are 8-byte aligned within the page-aligned mapping: read in place
+        const SnapshotOrder* orders = reinterpret_cast<const SnapshotOrder*>(pos);
+        Limit* limit = ladder.insert(level.price);
+
+        for (std::uint32_t i = 0; i < level.orderCount; i++) {
+            // A repeated ID would overwrite the first order's index entry and orphan it
+            if (orders[i].qty == 0 || orderMap.find(orders[i].id) != nullptr)
+                throw corrupt();
+            // IDs arrive in price-time order, i.e. scattered over the index: fetch ahead
+            if (i + SNAPSHOT_PREFETCH < level.orderCount)
+                orderMap.prefetch(orders[i + SNAPSHOT_PREFETCH].id);
+
+            Order* order = orderPool.acquire(orders[i].id, level.price, orders[i].qty, OrderType::LIMIT, side);
+            limit->addOrder(order);
+            orderMap.insert(orders[i].id, order);
+        }
+        pos += std::size_t(level.orderCount) * sizeof(SnapshotOrder);
+
+        syncDepth(side, level.price, limit);
+        if (side == Side::BUY) {
+            bestBid = std::max(bestBid, level.price);
+        } else {
+            bestAsk = std::min(bestAsk, level.price);
+        }
+    }
+
+    if (loaded != header.orderCount || bestBid != header.highestBid || bestAsk != header.lowestAsk || (header.bidLevels > 0 && header.askLevels > 0 && bestBid >= bestAsk))
+        throw corrupt();
+
+    highestBid = bestBid;
+    lowestAsk = bestAsk;
+
+    // Pending stops, re-queued FIFO per trigger. lastTradePrice is still 0 here, so
+    // addStop() cannot fire anything mid-load.
+    std::uint64_t loadedStops = 0;
+    for (std::uint64_t l = 0; l < stopLevelCount; l++) {
+        Side side = (l < header.buyStopLevels) ? Side::BUY : Side::SELL;
+
+        if (static_cast<std::uint64_t>(end - pos) < sizeof(SnapshotLevel))
+            throw corrupt();
+        SnapshotLevel level;
+        std::memcpy(&level, pos, sizeof(level));
+        pos += sizeof(level);
+
+        loadedStops += level.orderCount;
+        if (level.orderCount == 0 || loadedStops > header.stopCount || level.price == 0 || level.price >= MAX_PRICE ||
+            static_cast<std::uint64_t>(end - pos) < std::uint64_t(level.orderCount) * sizeof(SnapshotStop)) {
+            throw corrupt();
+        }
+
+        const SnapshotStop* stops = reinterpret_cast<const SnapshotStop*>(pos);
+        for (std::uint32_t i = 0; i < level.orderCount; i++) {
+            const SnapshotStop& stop = stops[i];
+            if (stop.qty == 0 || (stop.type != OrderType::STOP && stop.type != OrderType::STOP_LIMIT) ||
+                orderMap.find(stop.id) != nullptr) {
+                throw corrupt();
+            }
+            if (side == Side::BUY) {
+                addStop<Side::BUY>(stop.id, level.price, stop.limitPrice, stop.qty, stop.type);
+            } else {
+                addStop<Side::SELL>(stop.id, level.price, stop.limitPrice, stop.qty, stop.type);
+            }
+        }
+        pos += std::size_t(level.orderCount) * sizeof(SnapshotStop);
+    }
+
+    // A saved book never holds a stop its last trade already reached
+    lastTradePrice = header.lastTradePrice;
+    if (loadedStops != header.stopCount || stopsTriggered())
+        throw corrupt();
+}
+
+// Common instantiations are compiled once in Book.cpp
+extern template class BasicBook<NoopListener>;
+extern template class BasicBook<CallbackListener>;
+extern template class BasicBook<ExecutionBuffer>;
+
 #endif
\ No newline at end of file
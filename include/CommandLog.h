@@ -0,0 +1,71 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary command log: a 32-byte header followed by `recordCount` raw Command records.
+// Records are stored in the in-memory layout (native endianness, 24 bytes, zeroed
+// padding), so a mapped file can be handed to Book::process() without any decoding.
+constexpr std::uint64_t COMMAND_LOG_MAGIC = 0x474F4C444D43424FULL; // "OBCMDLOG"
+constexpr std::uint32_t COMMAND_LOG_VERSION = 1;
+
+struct CommandLogHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint64_t recordCount;
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(CommandLogHeader) == 32);
+static_assert(sizeof(Command) == 24 && std::is_trivially_copyable_v<Command>);
+// Records start right after the header, so they stay 8-byte aligned in a mapping
+static_assert(sizeof(CommandLogHeader) % alignof(Command) == 0);
+
+// Appends records through a large stdio buffer; the record count is patched into the
+// header by close(). Throws std::runtime_error on I/O failure.
+class CommandLogWriter {
+private:
+    std::FILE* file = nullptr;
+    std::uint64_t recordCount = 0;
+    std::vector<char> buffer;
+
+public:
+    explicit CommandLogWriter(const std::string& path);
+    ~CommandLogWriter();
+
+    CommandLogWriter(const CommandLogWriter&) = delete;
+    CommandLogWriter& operator=(const CommandLogWriter&) = delete;
+
+    void append(const Command& cmd);
+    void append(std::span<const Command> cmds);
+
+    // Flushes and finalises the header (idempotent; also run by the destructor)
+    void close();
+
+    std::uint64_t getRecordCount() const { return recordCount; }
+};
+
+// Read-only view of a command log over a MappedFile (records are used in place).
+// Throws std::runtime_error if the file is missing, truncated or not a command log.
+class CommandLogReader {
+private:
+    MappedFile file;
+
+    const Command* first = nullptr;
+    size_t count = 0;
+
+public:
+    explicit CommandLogReader(const std::string& path);
+
+    std::span<const Command> records() const { return {first, count}; }
+    size_t size() const { return count; }
+};
@@ -0,0 +1,469 @@
+#pragma once
+
+#include "Bitmask.h"
+#include "DepthCache.h"
+#include "OrderIndex.h"
+#include "TradeListener.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Order book with a compact, index-based layout, for books holding millions of resting
+// orders where BasicBook's 48-byte pointer-linked Orders stop fitting in cache.
+//  * Orders live in a pool addressed by 32-bit slot numbers. Queue links are slot
+//    numbers, and an order names its level by price offset instead of a parentLimit
+//    pointer, so the record the matching and cancel paths touch is 16 bytes.
+//  * Struct-of-arrays: hot (next, prev, qty, level) and cold (OrderId, post-only flag)
+//    state are separate arrays; the id is only read to report a fill or to unindex an
+//    order, the flag only by modifyOrder.
+//  * Levels are a dense table over a fixed price band, 16 bytes each, shared by both
+//    sides (an uncrossed book never rests a bid and an ask at the same price). One
+//    Bitmask per side finds the touch.
+// Slots never move, so the pool can grow without invalidating anything. The price band
+// is fixed at construction: orders outside it are rejected with std::out_of_range.
+// Supports limit / market / IOC / FOK / post-only / cancel / modify with the same
+// semantics as BasicBook (stop orders are BasicBook-only).
+template <typename Listener = NoopListener>
+class CompactBook {
+public:
+    // "No order" link value
+    static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+
+    // Hot per-order state (4 per cache line)
+    struct Node {
+        std::uint32_t next;
+        std::uint32_t prev;
+        Quantity qty;
+        // Price offset into the level table (price - minPrice)
+        std::uint32_t level;
+    };
+
+    struct Level {
+        std::uint32_t head = NIL;
+        std::uint32_t tail = NIL;
+        std::uint32_t size = 0;
+        Quantity totalVolume = 0;
+    };
+
+    static_assert(sizeof(Node) == 16 && sizeof(Level) == 16);
+
+private:
+    Price minPrice;
+    std::vector<Level> levels;
+    Bitmask bidLevels;
+    Bitmask askLevels;
+
+    Price highestBid = 0;
+    Price lowestAsk = MAX_PRICE;
+
+    // Order pool: parallel hot / cold arrays indexed by slot; free slots are chained through `next`
+    std::vector<Node> nodes;
+    std::vector<OrderId> ids;
+    // Slot rests a post-only order (a re-price may not cross the spread)
+    std::vector<std::uint8_t> postOnly;
+    std::uint32_t freeHead = NIL;
+    size_t liveOrders = 0;
+
+    // OrderId -> slot + 1 (0 = absent)
+    HashIndex<std::uint32_t> orderMap;
+
+    [[no_unique_address]] Listener listener;
+
+    static size_t bandWidth(Price low, Price high) {
+        if (low == 0 || high < low || high >= MAX_PRICE)
+            throw std::invalid_argument("CompactBook: price band must satisfy 0 < minPrice <= maxPrice < MAX_PRICE");
+        return static_cast<size_t>(high - low) + 1;
+    }
+
+    std::uint32_t levelOf(Price price) const {
+        if (price < minPrice || price - minPrice >= levels.size())
+            throw std::out_of_range("CompactBook: price outside the configured band");
+        return price - minPrice;
+    }
+
+    // A resting order at `level` is a bid iff it is at or below the best bid
+    bool isBidLevel(std::uint32_t level) const { return minPrice + level <= highestBid; }
+
+    std::uint32_t acquire(OrderId id, bool isPostOnly = false) {
+        std::uint32_t slot = freeHead;
+        if (slot != NIL) {
+            freeHead = nodes[slot].next;
+            ids[slot] = id;
+            postOnly[slot] = isPostOnly;
+        } else {
+            if (nodes.size() >= NIL) [[unlikely]]
+                throw std::length_error("CompactBook: more than 2^32 - 1 resting orders");
+            slot = static_cast<std::uint32_t>(nodes.size());
+            nodes.emplace_back();
+            ids.push_back(id);
+            postOnly.push_back(isPostOnly);
+        }
+        liveOrders++;
+        return slot;
+    }
+
+    void release(std::uint32_t slot) {
+        nodes[slot].next = freeHead;
+        freeHead = slot;
+        liveOrders--;
+    }
+
+    void updateBestBid() {
+        long long next = bidLevels.scanDesc(highestBid - minPrice);
+        highestBid = (next == -1) ? 0 : minPrice + static_cast<Price>(next);
+    }
+
+    void updateBestAsk() {
+        long long next = askLevels.scanAsc(lowestAsk - minPrice);
+        lowestAsk = (next == -1) ? MAX_PRICE : minPrice + static_cast<Price>(next);
+    }
+
+    void matchOrder(OrderId takerId, Price price, Quantity& fillQty, Side side);
+    // Appends `slot` (qty already set) to the back of `level`
+    void restOrder(std::uint32_t slot, std::uint32_t level, Side side);
+    // Detaches `slot` from its level (dropping the level if it empties)
+    void unlinkOrder(std::uint32_t slot);
+    // Whether a side-`side` order at `price` would take liquidity
+    bool crossesTouch(Price price, Side side) const {
+        return (side == Side::BUY) ? (lowestAsk != MAX_PRICE && lowestAsk <= price)
+                                   : (highestBid != 0 && highestBid >= price);
+    }
+    // Whether a side-`side` taker could fill `qty` up to `price` (read-only level walk)
+    bool canFill(Price price, Quantity qty, Side side) const;
+
+public:
+    // Accepts prices in [low, high]; the order pool is reserved for `maxOrders` and grows
+    // past it. `low` must be at least 1 (0 is the "no bids" sentinel); throws
+    // std::invalid_argument otherwise.
+    CompactBook(size_t maxOrders, Price low, Price high, Listener l = Listener())
+        : minPrice(low)
+        , levels(bandWidth(low, high))
+        , bidLevels(levels.size())
+        , askLevels(levels.size())
+        , orderMap(maxOrders)
+        , listener(std::move(l)) {
+        nodes.reserve(maxOrders);
+        ids.reserve(maxOrders);
+        postOnly.reserve(maxOrders);
+    }
+
+    void addLimitOrder(OrderId id, Price price, Quantity qty, Side side);
+    void addMarketOrder(OrderId id, Quantity qty, Side side);
+    // Same semantics as the BasicBook versions (FOK / post-only return false when rejected)
+    void addIocOrder(OrderId id, Price price, Quantity qty, Side side) { matchOrder(id, price, qty, side); }
+    bool addFokOrder(OrderId id, Price price, Quantity qty, Side side);
+    bool addPostOnlyOrder(OrderId id, Price price, Quantity qty, Side side);
+    void cancelOrder(OrderId id);
+    // Same semantics as BasicBook::modifyOrder
+    void modifyOrder(OrderId id, Price newPrice, Quantity newQty);
+
+    void process(const Command& cmd) {
+        switch (cmd.type) {
+        case OrderType::LIMIT:
+            addLimitOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+            break;
+        case OrderType::CANCEL:
+            cancelOrder(cmd.id);
+            break;
+        case OrderType::MARKET:
+            addMarketOrder(cmd.id, cmd.qty, cmd.side);
+            break;
+        case OrderType::MODIFY:
+            modifyOrder(cmd.id, cmd.price, cmd.qty);
+            break;
+        case OrderType::IOC:
+            addIocOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+            break;
+        case OrderType::FOK:
+            addFokOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+            break;
+        case OrderType::POST_ONLY:
+            addPostOnlyOrder(cmd.id, cmd.price, cmd.qty, cmd.side);
+            break;
+        case OrderType::STOP:
+        case OrderType::STOP_LIMIT:
+            throw std::invalid_argument("CompactBook: stop orders are not supported");
+        }
+    }
+
+    // Copies up to `n` levels of one side (best first) into `out`; returns the count written.
+    // Walks the bitmask, so it costs one scan per level (inspection, not the hot path).
+    size_t getDepth(Side side, DepthLevel* out, size_t n) const {
+        size_t count = 0;
+        if (side == Side::BUY) {
+            for (long long i = bidLevels.scanDesc(levels.size()); i != -1 && count < n;
+                 i = (i > 0) ? bidLevels.scanDesc(i - 1) : -1) {
+                const Level& level = levels[i];
+                out[count++] = {minPrice + static_cast<Price>(i), level.totalVolume, level.size};
+            }
+        } else {
+            for (long long i = askLevels.scanAsc(0); i != -1 && count < n; i = askLevels.scanAsc(i + 1)) {
+                const Level& level = levels[i];
+                out[count++] = {minPrice + static_cast<Price>(i), level.totalVolume, level.size};
+            }
+        }
+        return count;
+    }
+
+    std::optional<Price> getBestBid() const { return highestBid ? std::optional<Price>(highestBid) : std::nullopt; }
+    std::optional<Price> getBestAsk() const {
+        return lowestAsk != MAX_PRICE ? std::optional<Price>(lowestAsk) : std::nullopt;
+    }
+
+    // Resting quantity of an order, if it is in the book
+    std::optional<Quantity> getOrderQty(OrderId id) const {
+        std::uint32_t entry = orderMap.find(id);
+        return entry ? std::optional<Quantity>(nodes[entry - 1].qty) : std::nullopt;
+    }
+
+    size_t getOrderCount() const { return liveOrders; }
+    // Bytes held by the order pool, level table and index (16-byte slots), excluding the bitmasks
+    size_t getMemoryBytes() const {
+        return nodes.capacity() * sizeof(Node) + ids.capacity() * sizeof(OrderId) + postOnly.capacity() + levels.size() * sizeof(Level) +
+               orderMap.getSlotCount() * 16;
+    }
+
+    Listener& getListener() { return listener; }
+};
+
+template <typename Listener>
+void CompactBook<Listener>::matchOrder(OrderId takerId, Price price, Quantity& fillQty, Side side) {
+    while (fillQty > 0) {
+        // Empty or not profitable
+        if (side == Side::BUY && (lowestAsk == MAX_PRICE || lowestAsk > price))
+            break;
+        if (side == Side::SELL && (highestBid == 0 || highestBid < price))
+            break;
+
+        Price bestPrice = (side == Side::BUY) ? lowestAsk : highestBid;
+        std::uint32_t levelIdx = bestPrice - minPrice;
+        Level& level = levels[levelIdx];
+
+        while (fillQty > 0 && level.head != NIL) {
+            std::uint32_t slot = level.head;
+            Node& maker = nodes[slot];
+
+            Quantity tradeQty = std::min(fillQty, maker.qty);
+            listener.onTrade({
+                takerId,
+                ids[slot],
+                bestPrice,
+                tradeQty,
+                maker.qty - tradeQty,
+                maker.qty == tradeQty && level.size == 1,
+            });
+
+            fillQty -= tradeQty;
+            maker.qty -= tradeQty;
+            level.totalVolume -= tradeQty;
+
+            if (maker.qty == 0) {
+                level.head = maker.next;
+                if (level.head != NIL)
+                    nodes[level.head].prev = NIL;
+                else
+                    level.tail = NIL;
+                level.size--;
+
+                orderMap.erase(ids[slot]);
+                release(slot);
+            }
+        }
+
+        if (level.head == NIL) {
+            if (side == Side::BUY) {
+                askLevels.unset(levelIdx);
+                updateBestAsk();
+            } else {
+                bidLevels.unset(levelIdx);
+                updateBestBid();
+            }
+        }
+    }
+}
+
+template <typename Listener>
+void CompactBook<Listener>::restOrder(std::uint32_t slot, std::uint32_t levelIdx, Side side) {
+    Level& level = levels[levelIdx];
+    Node& node = nodes[slot];
+    node.level = levelIdx;
+    node.next = NIL;
+    node.prev = level.tail;
+
+    if (level.tail == NIL) {
+        level.head = slot;
+        Price price = minPrice + levelIdx;
+        if (side == Side::BUY) {
+            bidLevels.set(levelIdx);
+            highestBid = std::max(highestBid, price);
+        } else {
+            askLevels.set(levelIdx);
+            lowestAsk = std::min(lowestAsk, price);
+        }
+    } else {
+        nodes[level.tail].next = slot;
+    }
+    level.tail = slot;
+    level.size++;
+    level.totalVolume += node.qty;
+}
+
+template <typename Listener>
+void CompactBook<Listener>::unlinkOrder(std::uint32_t slot) {
+    const Node& node = nodes[slot];
+    Level& level = levels[node.level];
+
+    if (node.prev != NIL)
+        nodes[node.prev].next = node.next;
+    else
+        level.head = node.next;
+    if (node.next != NIL)
+        nodes[node.next].prev = node.prev;
+    else
+        level.tail = node.prev;
+
+    level.size--;
+    level.totalVolume -= node.qty;
+
+    if (level.size == 0) {
+        Price price = minPrice + node.level;
+        if (isBidLevel(node.level)) {
+            bidLevels.unset(node.level);
+            if (price == highestBid)
+                updateBestBid();
+        } else {
+            askLevels.unset(node.level);
+            if (price == lowestAsk)
+                updateBestAsk();
+        }
+    }
+}
+
+template <typename Listener>
+void CompactBook<Listener>::addLimitOrder(OrderId id, Price price, Quantity qty, Side side) {
+    std::uint32_t levelIdx = levelOf(price);
+    matchOrder(id, price, qty, side);
+
+    if (qty > 0) {
+        std::uint32_t slot = acquire(id);
+        nodes[slot].qty = qty;
+        orderMap.insert(id, slot + 1);
+        restOrder(slot, levelIdx, side);
+    }
+}
+
+template <typename Listener>
+void CompactBook<Listener>::addMarketOrder(OrderId id, Quantity qty, Side side) {
+    if (side == Side::BUY) {
+        matchOrder(id, std::numeric_limits<Price>::max(), qty, side);
+    } else {
+        matchOrder(id, std::numeric_limits<Price>::min(), qty, side);
+    }
+}
+
+template <typename Listener>
+bool CompactBook<Listener>::canFill(Price price, Quantity qty, Side side) const {
+    std::uint64_t available = 0;
+    if (side == Side::BUY) {
+        if (lowestAsk == MAX_PRICE || lowestAsk > price)
+            return false;
+        for (long long i = lowestAsk - minPrice; i != -1 && minPrice + static_cast<Price>(i) <= price;
+             i = askLevels.scanAsc(i + 1)) {
+            available += levels[i].totalVolume;
+            if (available >= qty)
+                return true;
+        }
+    } else {
+        if (highestBid == 0 || highestBid < price)
+            return false;
+        for (long long i = highestBid - minPrice; i != -1 && minPrice + static_cast<Price>(i) >= price;
+             i = (i > 0) ? bidLevels.scanDesc(i - 1) : -1) {
+            available += levels[i].totalVolume;
+            if (available >= qty)
+                return true;
+        }
+    }
+    return false;
+}
+
+template <typename Listener>
+bool CompactBook<Listener>::addFokOrder(OrderId id, Price price, Quantity qty, Side side) {
+    if (qty == 0 || !canFill(price, qty, side))
+        return false;
+
+    matchOrder(id, price, qty, side);
+    return true;
+}
+
+template <typename Listener>
+bool CompactBook<Listener>::addPostOnlyOrder(OrderId id, Price price, Quantity qty, Side side) {
+    std::uint32_t levelIdx = levelOf(price);
+    if (qty == 0 || crossesTouch(price, side))
+        return false;
+
+    std::uint32_t slot = acquire(id, true);
+    nodes[slot].qty = qty;
+    orderMap.insert(id, slot + 1);
+    restOrder(slot, levelIdx, side);
+    return true;
+}
+
+template <typename Listener>
+void CompactBook<Listener>::cancelOrder(OrderId id) {
+    std::uint32_t entry = orderMap.find(id);
+    if (entry == 0)
+        return;
+
+    unlinkOrder(entry - 1);
+    orderMap.erase(id);
+    release(entry - 1);
+}
+
+template <typename Listener>
+void CompactBook<Listener>::modifyOrder(OrderId id, Price newPrice, Quantity newQty) {
+    std::uint32_t entry = orderMap.find(id);
+    if (entry == 0)
+        return;
+
+    std::uint32_t slot = entry - 1;
+    Node& node = nodes[slot];
+
+    if (newQty == 0) {
+        cancelOrder(id);
+        return;
+    }
+
+    // Case A: Size-down at the same price: in place, queue position kept
+    if (newPrice == minPrice + node.level && newQty <= node.qty) {
+        levels[node.level].totalVolume -= node.qty - newQty;
+        node.qty = newQty;
+        return;
+    }
+
+    // Case B: Replace: leave the level, then behave like a fresh limit order
+    // while reusing the same slot and index entry
+    std::uint32_t newLevel = levelOf(newPrice);
+    Side side = isBidLevel(node.level) ? Side::BUY : Side::SELL;
+    // Post-only re-priced through the spread: ignored, as in BasicBook
+    if (postOnly[slot] && crossesTouch(newPrice, side))
+        return;
+    unlinkOrder(slot);
+
+    Quantity remaining = newQty;
+    matchOrder(id, newPrice, remaining, side);
+
+    if (remaining > 0) {
+        nodes[slot].qty = remaining;
+        restOrder(slot, newLevel, side);
+    } else {
+        orderMap.erase(id);
+        release(slot);
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// One aggregated L2 price level (12 bytes)
+struct DepthLevel {
+    Price price;
+    Quantity qty;
+    std::uint32_t orderCount;
+};
+
+constexpr size_t MAX_DEPTH_LEVELS = 10;
+static_assert(MAX_DEPTH_LEVELS > 1, "refill reads back() after dropping one level");
+
+// Contiguous best-first copy of the top N levels of one side, updated incrementally
+// by the Book whenever a level inside (or entering) the top N changes.
+// Invariant: if fewer than N levels are cached, the cache holds every level on the side.
+template <Side S>
+class DepthCache {
+private:
+    std::array<DepthLevel, MAX_DEPTH_LEVELS> levels{};
+    size_t count = 0;
+
+    // Strictly closer to the touch
+    static bool better(Price a, Price b) { return (S == Side::BUY) ? a > b : a < b; }
+
+public:
+
+    // Level at `price` now holds `qty` over `orderCount` orders (orderCount == 0: level gone).
+    // Returns true when a cached level was dropped from a full cache, i.e. the caller
+    // must append the next level beyond back() (if any) to restore the invariant.
+    bool update(Price price, Quantity qty, std::uint32_t orderCount) {
+        // Fast reject: deeper than everything in a full cache
+        if (count == MAX_DEPTH_LEVELS && better(levels[count - 1].price, price))
+            return false;
+
+        size_t i = 0;
+        while (i < count && better(levels[i].price, price)) {
+            i++;
+        }
+
+        if (i < count && levels[i].price == price) {
+            if (orderCount == 0) {
+                // Level removed: close the gap
+                bool wasFull = (count == MAX_DEPTH_LEVELS);
+                std::copy(levels.begin() + i + 1, levels.begin() + count, levels.begin() + i);
+                count--;
+                return wasFull;
+            }
+
+            levels[i].qty = qty;
+            levels[i].orderCount = orderCount;
+            return false;
+        }
+
+        // Removal of an uncached level, or new level deeper than a full cache
+        if (orderCount == 0 || i == MAX_DEPTH_LEVELS)
+            return false;
+
+        // New level inside the top N: shift worse levels down (last one falls off when full)
+        size_t last = (count == MAX_DEPTH_LEVELS) ? count - 1 : count;
+        std::copy_backward(levels.begin() + i, levels.begin() + last, levels.begin() + last + 1);
+        levels[i] = {price, qty, orderCount};
+        if (count < MAX_DEPTH_LEVELS)
+            count++;
+
+        return false;
+    }
+
+    // Appends the next-deeper level after a refill request from update()
+    void append(const DepthLevel& level) { levels[count++] = level; }
+
+    void clear() { count = 0; }
+
+    const DepthLevel* data() const { return levels.data(); }
+    const DepthLevel& back() const { return levels[count - 1]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
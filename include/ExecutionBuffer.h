@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Listener policy that batches execution reports instead of notifying per fill.
+// The match loop only appends a 32-byte Trade to a preallocated contiguous array;
+// the consumer drains the whole batch once per order (or per group of orders)
+// and can publish it in bulk.
+class ExecutionBuffer {
+private:
+    std::vector<Trade> fills;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    ExecutionBuffer(size_t capacity = DEFAULT_CAPACITY) { fills.reserve(capacity); }
+
+    // Listener interface (called from the fill loop)
+    void onTrade(const Trade& trade) { fills.push_back(trade); }
+
+    // Fills recorded since the last drain, in execution order
+    std::span<const Trade> pending() const { return fills; }
+
+    size_t size() const { return fills.size(); }
+    bool empty() const { return fills.empty(); }
+
+    // Hands the pending batch to `fn` as one contiguous span, then resets the buffer.
+    // Capacity is kept, so steady-state appends never allocate.
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        size_t n = fills.size();
+        if (n != 0) {
+            fn(std::span<const Trade>(fills));
+            fills.clear();
+        }
+        return n;
+    }
+
+    void clear() { fills.clear(); }
+};
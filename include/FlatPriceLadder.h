@@ -0,0 +1,230 @@
+#pragma once
+
+#include "Bitmask.h"
+#include "Limit.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// PriceLadder variant that stores the level headers themselves in the window, instead
+// of Limit* into a pool (ladder policy for BasicBook<Listener, Index, Ladder>).
+//  * find() near the touch is a Bitmask test plus an address computation: no dependent
+//    Limit* load before the header.
+//  * Creating or dropping a window level writes the header and flips its bit; there is
+//    no Limit pool to acquire from or release to. The Bitmask alone says which are live.
+//  * Far levels live in an ordered map of Limits (node-based, so they do not move).
+// Limits are not address-stable across recenter(): every level that changes place is
+// copied and the parentLimit of each order in its queue is rewritten. recenter() costs
+// O(resting orders in moved levels) rather than O(levels); it only runs when the touch
+// leaves the window.
+class FlatPriceLadder {
+private:
+    Price base = 0;
+    size_t width;
+
+    // Dense window: index = price - base; a header is live iff its bit is set
+    std::vector<Limit> window;
+    Bitmask windowMask;
+
+    // Far-away levels (below base or at/above base + width)
+    std::map<Price, Limit> overflow;
+
+    size_t levelCount = 0;
+
+    // Scratch space for recenter(), reserved once
+    std::vector<Limit> displaced;
+
+    std::uint64_t windowEnd() const { return static_cast<std::uint64_t>(base) + width; }
+
+    // Points every order queued on `limit` back at it (after the header was copied)
+    static void adopt(Limit& limit) {
+        for (Order* order = limit.head; order != nullptr; order = order->nextOrder) {
+            order->parentLimit = &limit;
+        }
+    }
+
+    void place(const Limit& limit) {
+        Price price = limit.limitPrice;
+        Limit* slot;
+        if (inWindow(price)) {
+            slot = &window[price - base];
+            *slot = limit;
+            windowMask.set(price - base);
+        } else {
+            slot = &overflow.emplace(price, limit).first->second;
+        }
+        adopt(*slot);
+    }
+
+public:
+    FlatPriceLadder(size_t windowWidth)
+        : width(windowWidth)
+        , window(windowWidth, Limit(0))
+        , windowMask(windowWidth) {
+        displaced.reserve(windowWidth);
+    }
+
+    FlatPriceLadder(const FlatPriceLadder&) = delete;
+    FlatPriceLadder& operator=(const FlatPriceLadder&) = delete;
+
+    bool inWindow(Price price) const { return static_cast<Price>(price - base) < width; }
+
+    Limit* find(Price price) {
+        return const_cast<Limit*>(static_cast<const FlatPriceLadder*>(this)->find(price));
+    }
+    const Limit* find(Price price) const {
+        if (inWindow(price))
+            return windowMask.test(price - base) ? &window[price - base] : nullptr;
+
+        auto it = overflow.find(price);
+        return (it == overflow.end()) ? nullptr : &it->second;
+    }
+
+    // Window-only lookup (nullptr outside the window): never touches the overflow map
+    const Limit* peek(Price price) const {
+        return (inWindow(price) && windowMask.test(price - base)) ? &window[price - base] : nullptr;
+    }
+
+    // Cache hint for the window header of `price` (overflow levels are cold anyway)
+    void prefetch(Price price) const {
+        if (inWindow(price))
+            __builtin_prefetch(&window[price - base]);
+    }
+
+    // Creates an empty level at `price` (must not already exist)
+    Limit* insert(Price price) {
+        levelCount++;
+        if (inWindow(price)) {
+            Limit& limit = window[price - base];
+            limit = Limit(price);
+            windowMask.set(price - base);
+            return &limit;
+        }
+        return &overflow.emplace(price, Limit(price)).first->second;
+    }
+
+    // Removes the level at `price` (no-op if absent)
+    void erase(Price price) {
+        if (inWindow(price)) {
+            if (windowMask.test(price - base)) {
+                windowMask.unset(price - base);
+                levelCount--;
+            }
+        } else if (overflow.erase(price)) {
+            levelCount--;
+        }
+    }
+
+    // Lowest populated price >= startPrice, or -1
+    long long scanAsc(Price startPrice) const {
+        if (!overflow.empty() && startPrice < base) {
+            auto it = overflow.lower_bound(startPrice);
+            if (it != overflow.end() && it->first < base)
+                return it->first;
+        }
+
+        std::uint64_t start = std::max(startPrice, base);
+        if (start < windowEnd()) {
+            long long next = windowMask.scanAsc(start - base);
+            if (next != -1)
+                return base + next;
+        }
+
+        if (!overflow.empty()) {
+            auto it = overflow.lower_bound(static_cast<Price>(std::max<std::uint64_t>(startPrice, windowEnd())));
+            if (it != overflow.end())
+                return it->first;
+        }
+
+        return -1;
+    }
+
+    // Highest populated price <= startPrice, or -1
+    long long scanDesc(Price startPrice) const {
+        if (!overflow.empty() && startPrice >= windowEnd()) {
+            auto it = overflow.upper_bound(startPrice);
+            if (it != overflow.begin() && (--it)->first >= windowEnd())
+                return it->first;
+        }
+
+        if (startPrice >= base) {
+            std::uint64_t start = std::min<std::uint64_t>(startPrice, windowEnd() - 1);
+            long long next = windowMask.scanDesc(start - base);
+            if (next != -1)
+                return base + next;
+        }
+
+        if (!overflow.empty() && base > 0) {
+            auto it = overflow.upper_bound(std::min<Price>(startPrice, base - 1));
+            if (it != overflow.begin())
+                return (--it)->first;
+        }
+
+        return -1;
+    }
+
+    // Slides the window so that `center` sits in its middle, re-pointing the orders of
+    // every level that moves
+    void recenter(Price center) {
+        std::uint64_t half = width / 2;
+        std::uint64_t maxBase = (MAX_PRICE > width) ? MAX_PRICE - width : 0;
+        Price newBase = static_cast<Price>(std::min<std::uint64_t>(center > half ? center - half : 0, maxBase));
+
+        if (newBase == base)
+            return;
+
+        // 1. Lift every populated window level out
+        displaced.clear();
+        for (long long idx = windowMask.scanAsc(0); idx != -1; idx = windowMask.scanAsc(idx + 1)) {
+            displaced.push_back(window[idx]);
+            windowMask.unset(idx);
+        }
+
+        base = newBase;
+
+        // 2. Pull overflow levels that now fall inside the window
+        auto it = overflow.lower_bound(base);
+        while (it != overflow.end() && it->first < windowEnd()) {
+            Limit& slot = window[it->first - base];
+            slot = it->second;
+            windowMask.set(it->first - base);
+            adopt(slot);
+            it = overflow.erase(it);
+        }
+
+        // 3. Re-seat the lifted levels (window if still covered, otherwise overflow)
+        for (const Limit& limit : displaced) {
+            place(limit);
+        }
+    }
+
+    template <typename Fn>
+    void forEachLevel(Fn&& fn) const {
+        for (long long idx = windowMask.scanAsc(0); idx != -1; idx = windowMask.scanAsc(idx + 1)) {
+            fn(&window[idx]);
+        }
+        for (const auto& [price, limit] : overflow) {
+            fn(&limit);
+        }
+    }
+
+    // Drops every level and resets the window
+    void clear() {
+        for (long long idx = windowMask.scanAsc(0); idx != -1; idx = windowMask.scanAsc(idx + 1)) {
+            windowMask.unset(idx);
+        }
+        overflow.clear();
+        levelCount = 0;
+        base = 0;
+    }
+
+    bool empty() const { return levelCount == 0; }
+    size_t getLevelCount() const { return levelCount; }
+    Price getBase() const { return base; }
+    size_t getWidth() const { return width; }
+    // Window and level-header storage (overflow map nodes excluded)
+    size_t getMemoryBytes() const { return window.capacity() * sizeof(Limit); }
+};
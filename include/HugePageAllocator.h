@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+// Huge pages cut TLB misses on large pools: one 2MB entry covers what would
+// otherwise take 512 x 4KB entries.
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr size_t BASE_PAGE_SIZE = 4096;
+
+struct MemoryRegion {
+    void* base = nullptr;
+    size_t bytes = 0;
+    // Backed by explicit (hugetlbfs) 2MB pages rather than transparent huge pages / 4KB pages
+    bool hugeTlb = false;
+};
+
+// Allocates a page-aligned region of at least `bytes`.
+// Linux: regions >= 2MB try MAP_HUGETLB first, then fall back to regular pages with
+// madvise(MADV_HUGEPAGE). `populate` pre-faults the pages during the call (MAP_POPULATE for
+// hugetlb; after the THP advice, MADV_POPULATE_WRITE or a touch loop for regular pages).
+// Other platforms: plain aligned allocation.
+MemoryRegion allocateRegion(size_t bytes, bool populate);
+
+void releaseRegion(const MemoryRegion& region);
+
+// Touches one byte per page so no page fault is left for the hot path
+void prefaultRegion(const MemoryRegion& region);
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "Book.h"
+#include "Types.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+// NASDAQ TotalView-ITCH 5.0 feed handling.
+//  * Messages are decoded in place: fields are read straight out of the feed buffer
+//    (a packet, or a whole MappedFile) with big-endian loads, never copied into structs.
+//  * Order messages are routed to one Book per Stock Locate; books are created lazily.
+//  * Adds and replaces rest without matching: they are orders already resting at the
+//    exchange (a locked / crossed feed book must not trade locally), and their fills
+//    arrive later as E / C messages.
+//  * Only the order-book messages (A, F, E, C, X, D, U) act on books; every other message
+//    type (system events, directory, trading actions, trades, NOII, ...) is skipped.
+// ITCH prices are 4-decimal fixed point, which is used unchanged as the book's tick.
+namespace itch {
+
+// --- Big-endian field loads (unaligned-safe) ---
+inline std::uint16_t load16(const std::uint8_t* p) {
+    std::uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return (std::endian::native == std::endian::little) ? __builtin_bswap16(v) : v;
+}
+
+inline std::uint32_t load32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return (std::endian::native == std::endian::little) ? __builtin_bswap32(v) : v;
+}
+
+inline std::uint64_t load64(const std::uint8_t* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return (std::endian::native == std::endian::little) ? __builtin_bswap64(v) : v;
+}
+
+// --- Message layout (lengths exclude the 2-byte frame length) ---
+constexpr char ADD_ORDER = 'A';
+constexpr char ADD_ORDER_MPID = 'F';
+constexpr char ORDER_EXECUTED = 'E';
+constexpr char ORDER_EXECUTED_PRICE = 'C';
+constexpr char ORDER_CANCEL = 'X';
+constexpr char ORDER_DELETE = 'D';
+constexpr char ORDER_REPLACE = 'U';
+
+constexpr size_t ADD_ORDER_LEN = 36;
+constexpr size_t ADD_ORDER_MPID_LEN = 40;
+constexpr size_t ORDER_EXECUTED_LEN = 31;
+constexpr size_t ORDER_EXECUTED_PRICE_LEN = 36;
+constexpr size_t ORDER_CANCEL_LEN = 23;
+constexpr size_t ORDER_DELETE_LEN = 19;
+constexpr size_t ORDER_REPLACE_LEN = 35;
+
+// Common header: type(1) locate(2) tracking(2) timestamp(6)
+constexpr size_t OFF_LOCATE = 1;
+constexpr size_t OFF_TIMESTAMP = 5;
+constexpr size_t OFF_ORDER_REF = 11;
+// Add: side(1) shares(4) stock(8) price(4)
+constexpr size_t OFF_ADD_SIDE = 19;
+constexpr size_t OFF_ADD_SHARES = 20;
+constexpr size_t OFF_ADD_STOCK = 24;
+constexpr size_t OFF_ADD_PRICE = 32;
+// Executed / Cancel: shares(4); Executed w/ Price adds match(8) printable(1) price(4)
+constexpr size_t OFF_EXEC_SHARES = 19;
+constexpr size_t OFF_EXEC_PRINTABLE = 31;
+constexpr size_t OFF_EXEC_PRICE = 32;
+// Replace: new ref(8) shares(4) price(4)
+constexpr size_t OFF_REPLACE_NEW_REF = 19;
+constexpr size_t OFF_REPLACE_SHARES = 27;
+constexpr size_t OFF_REPLACE_PRICE = 31;
+
+constexpr size_t MAX_LOCATES = 1 << 16;
+
+struct FeedStats {
+    std::uint64_t messages = 0;
+    std::uint64_t adds = 0;
+    std::uint64_t executions = 0;
+    std::uint64_t cancels = 0;
+    std::uint64_t deletes = 0;
+    std::uint64_t replaces = 0;
+    // Well-formed messages of types that do not touch a book
+    std::uint64_t skipped = 0;
+    // Order messages shorter than their fixed layout, or a cut-off frame
+    std::uint64_t malformed = 0;
+};
+
+// --- Encoding (sample generation and tests) ---
+
+// Appends length-framed ITCH messages to a byte buffer
+class Encoder {
+private:
+    std::vector<std::uint8_t> out;
+
+    static void put16(std::uint8_t* p, std::uint16_t v) {
+        p[0] = static_cast<std::uint8_t>(v >> 8);
+        p[1] = static_cast<std::uint8_t>(v);
+    }
+    static void put32(std::uint8_t* p, std::uint32_t v) {
+        put16(p, static_cast<std::uint16_t>(v >> 16));
+        put16(p + 2, static_cast<std::uint16_t>(v));
+    }
+    static void put64(std::uint8_t* p, std::uint64_t v) {
+        put32(p, static_cast<std::uint32_t>(v >> 32));
+        put32(p + 4, static_cast<std::uint32_t>(v));
+    }
+
+    // Starts a zeroed message body of `len` bytes with the common header filled in
+    std::uint8_t* begin(char type, size_t len, std::uint16_t locate, std::uint64_t timestamp) {
+        size_t at = out.size();
+        out.resize(at + 2 + len, 0);
+        put16(&out[at], static_cast<std::uint16_t>(len));
+
+        std::uint8_t* msg = &out[at + 2];
+        msg[0] = static_cast<std::uint8_t>(type);
+        put16(msg + OFF_LOCATE, locate);
+        put16(msg + OFF_TIMESTAMP, static_cast<std::uint16_t>(timestamp >> 32));
+        put32(msg + OFF_TIMESTAMP + 2, static_cast<std::uint32_t>(timestamp));
+        return msg;
+    }
+
+public:
+    void addOrder(std::uint16_t locate, std::uint64_t ref, Side side, Quantity shares, Price price,
+                  std::uint64_t timestamp = 0, bool withMpid = false) {
+        std::uint8_t* msg = begin(withMpid ? ADD_ORDER_MPID : ADD_ORDER, withMpid ? ADD_ORDER_MPID_LEN : ADD_ORDER_LEN,
+                                  locate, timestamp);
+        put64(msg + OFF_ORDER_REF, ref);
+        msg[OFF_ADD_SIDE] = (side == Side::BUY) ? 'B' : 'S';
+        put32(msg + OFF_ADD_SHARES, shares);
+        std::memset(msg + OFF_ADD_STOCK, ' ', 8);
+        put32(msg + OFF_ADD_PRICE, price);
+    }
+
+    void orderExecuted(std::uint16_t locate, std::uint64_t ref, Quantity shares, std::uint64_t timestamp = 0) {
+        std::uint8_t* msg = begin(ORDER_EXECUTED, ORDER_EXECUTED_LEN, locate, timestamp);
+        put64(msg + OFF_ORDER_REF, ref);
+        put32(msg + OFF_EXEC_SHARES, shares);
+    }
+
+    void orderExecutedWithPrice(std::uint16_t locate, std::uint64_t ref, Quantity shares, Price price,
+                                std::uint64_t timestamp = 0) {
+        std::uint8_t* msg = begin(ORDER_EXECUTED_PRICE, ORDER_EXECUTED_PRICE_LEN, locate, timestamp);
+        put64(msg + OFF_ORDER_REF, ref);
+        put32(msg + OFF_EXEC_SHARES, shares);
+        msg[OFF_EXEC_PRINTABLE] = 'Y';
+        put32(msg + OFF_EXEC_PRICE, price);
+    }
+
+    void orderCancel(std::uint16_t locate, std::uint64_t ref, Quantity shares, std::uint64_t timestamp = 0) {
+        std::uint8_t* msg = begin(ORDER_CANCEL, ORDER_CANCEL_LEN, locate, timestamp);
+        put64(msg + OFF_ORDER_REF, ref);
+        put32(msg + OFF_EXEC_SHARES, shares);
+    }
+
+    void orderDelete(std::uint16_t locate, std::uint64_t ref, std::uint64_t timestamp = 0) {
+        std::uint8_t* msg = begin(ORDER_DELETE, ORDER_DELETE_LEN, locate, timestamp);
+        put64(msg + OFF_ORDER_REF, ref);
+    }
+
+    void orderReplace(std::uint16_t locate, std::uint64_t oldRef, std::uint64_t newRef, Quantity shares, Price price,
+                      std::uint64_t timestamp = 0) {
+        std::uint8_t* msg = begin(ORDER_REPLACE, ORDER_REPLACE_LEN, locate, timestamp);
+        put64(msg + OFF_ORDER_REF, oldRef);
+        put64(msg + OFF_REPLACE_NEW_REF, newRef);
+        put32(msg + OFF_REPLACE_SHARES, shares);
+        put32(msg + OFF_REPLACE_PRICE, price);
+    }
+
+    // System Event ('S', 12 bytes): not a book message, exercises the skip path
+    void systemEvent(char code, std::uint64_t timestamp = 0) { begin('S', 12, 0, timestamp)[11] = static_cast<std::uint8_t>(code); }
+
+    const std::vector<std::uint8_t>& bytes() const { return out; }
+    void clear() { out.clear(); }
+};
+
+} // namespace itch
+
+template <typename BookT = BasicBook<NoopListener>>
+class ItchFeedHandler {
+private:
+    // Indexed by Stock Locate
+    std::vector<std::unique_ptr<BookT>> books;
+    size_t ordersPerBook;
+    itch::FeedStats stats;
+
+    BookT& bookFor(std::uint16_t locate) {
+        std::unique_ptr<BookT>& book = books[locate];
+        if (!book) [[unlikely]] {
+            book = std::make_unique<BookT>(ordersPerBook);
+        }
+        return *book;
+    }
+
+public:
+    // `ordersPerBook` sizes each book's initial pools; they grow on demand
+    explicit ItchFeedHandler(size_t ordersPerBook = 4096)
+        : books(itch::MAX_LOCATES)
+        , ordersPerBook(ordersPerBook) {}
+
+    // Applies one unframed message; returns false if it was too short to decode.
+    // Messages for a Stock Locate with no prior Add are ignored.
+    bool onMessage(const std::uint8_t* msg, size_t len) {
+        using namespace itch;
+
+        if (len == 0) {
+            stats.malformed++;
+            return false;
+        }
+        stats.messages++;
+
+        auto fits = [&](size_t need) {
+            if (len >= need)
+                return true;
+            stats.malformed++;
+            return false;
+        };
+
+        switch (static_cast<char>(msg[0])) {
+        case ADD_ORDER:
+        case ADD_ORDER_MPID:
+            if (!fits(ADD_ORDER_LEN))
+                return false;
+            bookFor(load16(msg + OFF_LOCATE)).restLimitOrder(load64(msg + OFF_ORDER_REF), load32(msg + OFF_ADD_PRICE),
+                                           load32(msg + OFF_ADD_SHARES), (msg[OFF_ADD_SIDE] == 'B') ? Side::BUY : Side::SELL);
+            stats.adds++;
+            return true;
+
+        case ORDER_EXECUTED:
+        case ORDER_EXECUTED_PRICE:
+            // Executions print against the resting order; the execution price of 'C' is informational
+            if (!fits(ORDER_EXECUTED_LEN))
+                return false;
+            if (BookT* book = getBook(load16(msg + OFF_LOCATE)))
+                book->reduceOrder(load64(msg + OFF_ORDER_REF), load32(msg + OFF_EXEC_SHARES));
+            stats.executions++;
+            return true;
+
+        case ORDER_CANCEL:
+            if (!fits(ORDER_CANCEL_LEN))
+                return false;
+            if (BookT* book = getBook(load16(msg + OFF_LOCATE)))
+                book->reduceOrder(load64(msg + OFF_ORDER_REF), load32(msg + OFF_EXEC_SHARES));
+            stats.cancels++;
+            return true;
+
+        case ORDER_DELETE:
+            if (!fits(ORDER_DELETE_LEN))
+                return false;
+            if (BookT* book = getBook(load16(msg + OFF_LOCATE)))
+                book->cancelOrder(load64(msg + OFF_ORDER_REF));
+            stats.deletes++;
+            return true;
+
+        case ORDER_REPLACE:
+            if (!fits(ORDER_REPLACE_LEN))
+                return false;
+            if (BookT* book = getBook(load16(msg + OFF_LOCATE)))
+                book->restReplaceOrder(load64(msg + OFF_ORDER_REF), load64(msg + OFF_REPLACE_NEW_REF),
+                                       load32(msg + OFF_REPLACE_PRICE), load32(msg + OFF_REPLACE_SHARES));
+            stats.replaces++;
+            return true;
+
+        default:
+            stats.skipped++;
+            return true;
+        }
+    }
+
+    // Applies a stream of [2-byte big-endian length][message] frames (the layout of
+    // NASDAQ's binary ITCH files). Returns the bytes consumed; a trailing partial frame
+    // is left unconsumed so the caller can prepend it to the next buffer.
+    size_t processStream(std::span<const std::uint8_t> data) {
+        size_t pos = 0;
+
+        while (data.size() - pos >= 2) {
+            size_t len = itch::load16(data.data() + pos);
+            if (data.size() - pos - 2 < len)
+                break;
+
+            onMessage(data.data() + pos + 2, len);
+            pos += 2 + len;
+        }
+
+        return pos;
+    }
+
+    // Book for a Stock Locate, or nullptr if no order message has referenced it
+    BookT* getBook(std::uint16_t locate) const { return books[locate].get(); }
+
+    size_t getBookCount() const {
+        size_t n = 0;
+        for (const auto& book : books) {
+            n += (book != nullptr);
+        }
+        return n;
+    }
+
+    const itch::FeedStats& getStats() const { return stats; }
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "SPSCQueue.h"
+#include "Threading.h"
+#include "Types.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Write-ahead journal of inbound commands, kept off the matching thread.
+//  * The matching thread stamps each command with a sequence number and pushes it into
+//    an SPSC ring: no syscall, no lock, no allocation.
+//  * A writer thread drains the ring into large sequential writes (io_uring where the
+//    kernel supports it, pwrite otherwise) and group-commits them with fdatasync.
+//  * getDurableSequence() tells the matching side how far the journal is on disk.
+// File layout: JournalHeader, then JournalRecord x N (a torn trailing record is ignored
+// on recovery).
+constexpr std::uint64_t JOURNAL_MAGIC = 0x4C4E52554F4A424FULL; // "OBJOURNL"
+constexpr std::uint32_t JOURNAL_VERSION = 1;
+
+struct JournalHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t recordSize;
+};
+
+struct JournalRecord {
+    std::uint64_t sequence;
+    Command command;
+};
+
+static_assert(sizeof(JournalHeader) == 16 && sizeof(JournalRecord) == 32);
+static_assert(std::is_trivially_copyable_v<JournalRecord>);
+
+enum class JournalBackend {
+    AUTO,     // io_uring if the kernel allows it, otherwise pwrite
+    PWRITE,   // synchronous pwrite + fdatasync
+    IO_URING, // asynchronous writes (throws if unavailable)
+};
+
+struct JournalConfig {
+    // Ring between the matching thread and the writer
+    size_t queueCapacity = 1 << 16;
+    // Largest single write; the writer double-buffers two of these
+    size_t batchBytes = 1 << 20;
+    // Group commit: fdatasync once this many bytes are unsynced (0 = never sync) ...
+    size_t syncBytes = 4 << 20;
+    // ... or once the oldest unsynced write is this old
+    std::chrono::microseconds syncInterval{1000};
+    JournalBackend backend = JournalBackend::AUTO;
+    // Core for the writer thread (-1 = not pinned)
+    int writerCore = -1;
+};
+
+struct JournalStats {
+    std::uint64_t records = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t syncs = 0;
+};
+
+class JournalIo;
+
+class Journal {
+private:
+    JournalConfig config;
+    SPSCQueue<JournalRecord> queue;
+
+    // Producer (matching thread) only
+    std::uint64_t nextSequence = 1;
+    std::uint64_t appendStalls = 0;
+
+    std::atomic<std::uint64_t> durableSequence{0};
+    std::atomic<bool> running{false};
+    std::atomic<bool> failed{false};
+    std::unique_ptr<JournalIo> io;
+    JournalStats stats;
+    std::thread writer;
+
+    void run();
+
+public:
+    // Creates (truncates) `path`. Throws std::runtime_error if it cannot be opened, or if
+    // IO_URING was requested and the kernel refuses it.
+    explicit Journal(const std::string& path, JournalConfig cfg = JournalConfig());
+    // Drains, syncs and closes (see stop())
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Matching thread: journals `cmd` and returns its sequence number. Only spins if the
+    // writer has fallen a whole ring behind (counted in getAppendStalls()).
+    std::uint64_t append(const Command& cmd) {
+        JournalRecord record{nextSequence, cmd};
+        while (!queue.push(record)) [[unlikely]] {
+            appendStalls++;
+            cpuRelax();
+        }
+        return nextSequence++;
+    }
+
+    // Writes and syncs everything appended so far, then joins the writer (idempotent)
+    void stop();
+
+    // Highest sequence number known to be on stable storage (0 = none yet)
+    std::uint64_t getDurableSequence() const { return durableSequence.load(std::memory_order_acquire); }
+    // The writer hit an I/O error; later records are drained but not written
+    bool hasFailed() const { return failed.load(std::memory_order_acquire); }
+    std::uint64_t getAppendStalls() const { return appendStalls; }
+    const char* getBackendName() const;
+    // Writer counters (stable once stop() has returned)
+    const JournalStats& getStats() const { return stats; }
+};
+
+// Recovery: the complete records of a journal file, read in place from a MappedFile.
+// Throws std::runtime_error if the file is missing or is not a journal.
+class JournalReader {
+private:
+    MappedFile file;
+    const JournalRecord* first = nullptr;
+    size_t count = 0;
+
+public:
+    explicit JournalReader(const std::string& path);
+
+    std::span<const JournalRecord> records() const { return {first, count}; }
+    size_t size() const { return count; }
+};
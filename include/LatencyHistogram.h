@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-memory log-linear (HDR-style) histogram of tick counts (see Tsc.h).
+//  * Values below 2^SUB_BITS get one bucket each; above that, every power of two is split
+//    into 2^SUB_BITS equal sub-buckets, so any recorded value is known to within ~3%.
+//  * record() is a shift, a count-leading-zeros and an increment: no allocation, no sort.
+//  * Single writer. Counters are relaxed atomics written with plain load/store, so another
+//    thread may query percentiles at any time (a snapshot may be a few records stale).
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 5;
+    static constexpr std::uint64_t SUB_COUNT = 1ULL << SUB_BITS;
+    // Values are clamped below 2^MAX_BITS ticks (minutes at GHz rates)
+    static constexpr unsigned MAX_BITS = 40;
+    static constexpr size_t BUCKET_COUNT = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+    static constexpr std::uint64_t MAX_VALUE = (1ULL << MAX_BITS) - 1;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> maxValue{0};
+
+    // Single-writer increment: no lock prefix, still race-free for readers
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+public:
+    static size_t bucketOf(std::uint64_t value) {
+        value = std::min(value, MAX_VALUE);
+        if (value < SUB_COUNT)
+            return static_cast<size_t>(value);
+
+        // value >> shift lands in [SUB_COUNT, 2 * SUB_COUNT)
+        unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - SUB_BITS;
+        return static_cast<size_t>((shift + 1) * SUB_COUNT + ((value >> shift) & (SUB_COUNT - 1)));
+    }
+
+    // Smallest and largest value mapping to `bucket`
+    static std::uint64_t bucketLow(size_t bucket) {
+        if (bucket < 2 * SUB_COUNT)
+            return bucket;
+        unsigned shift = static_cast<unsigned>(bucket / SUB_COUNT) - 1;
+        return (SUB_COUNT + bucket % SUB_COUNT) << shift;
+    }
+    static std::uint64_t bucketHigh(size_t bucket) {
+        unsigned shift = (bucket < 2 * SUB_COUNT) ? 0 : static_cast<unsigned>(bucket / SUB_COUNT) - 1;
+        return bucketLow(bucket) + (1ULL << shift) - 1;
+    }
+
+    void record(std::uint64_t ticks) {
+        add(buckets[bucketOf(ticks)], 1);
+        add(total, 1);
+        add(sum, ticks);
+        if (ticks > maxValue.load(std::memory_order_relaxed))
+            maxValue.store(ticks, std::memory_order_relaxed);
+    }
+
+    // Value at or below which a fraction `q` of the records fall, reported as the top of
+    // its bucket (never above the exact maximum). 0 if empty.
+    std::uint64_t percentile(double q) const {
+        std::uint64_t count = getCount();
+        if (count == 0)
+            return 0;
+
+        std::uint64_t target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(q * count + 0.5));
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+                return std::min(bucketHigh(i), getMax());
+        }
+        return getMax();
+    }
+
+    std::uint64_t getCount() const { return total.load(std::memory_order_relaxed); }
+    std::uint64_t getMax() const { return maxValue.load(std::memory_order_relaxed); }
+    double getMean() const {
+        std::uint64_t count = getCount();
+        return count ? static_cast<double>(sum.load(std::memory_order_relaxed)) / count : 0.0;
+    }
+
+    // Accumulates another histogram (e.g. several runs or several books)
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            add(buckets[i], other.buckets[i].load(std::memory_order_relaxed));
+        }
+        add(total, other.getCount());
+        add(sum, other.sum.load(std::memory_order_relaxed));
+        maxValue.store(std::max(getMax(), other.getMax()), std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        total.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Operations timed by the Book; limit orders are split by whether they crossed on arrival
+// (post-only orders never match, and placing a stop never does either: both count as LIMIT_REST)
+enum class LatencyOp : std::uint8_t {
+    LIMIT_REST,
+    LIMIT_MATCH,
+    MARKET,
+    CANCEL,
+    MODIFY,
+    // IOC and FOK (matched or killed, never rested)
+    IMMEDIATE,
+    COUNT,
+};
+
+inline const char* latencyOpName(LatencyOp op) {
+    switch (op) {
+    case LatencyOp::LIMIT_REST:
+        return "limit (rest)";
+    case LatencyOp::LIMIT_MATCH:
+        return "limit (match)";
+    case LatencyOp::MARKET:
+        return "market";
+    case LatencyOp::CANCEL:
+        return "cancel";
+    case LatencyOp::MODIFY:
+        return "modify";
+    case LatencyOp::IMMEDIATE:
+        return "ioc / fok";
+    default:
+        return "?";
+    }
+}
+
+// One histogram per LatencyOp (~9KB each)
+class OperationLatency {
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyOp::COUNT)> histograms;
+
+public:
+    LatencyHistogram& operator[](LatencyOp op) { return histograms[static_cast<size_t>(op)]; }
+    const LatencyHistogram& operator[](LatencyOp op) const { return histograms[static_cast<size_t>(op)]; }
+
+    void merge(const OperationLatency& other) {
+        for (size_t i = 0; i < histograms.size(); i++) {
+            histograms[i].merge(other.histograms[i]);
+        }
+    }
+
+    void reset() {
+        for (auto& h : histograms) {
+            h.reset();
+        }
+    }
+};
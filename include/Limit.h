@@ -59,6 +59,7 @@ struct Limit {
 
         // Update Size
         size--;
+        totalVolume -= order->qty;
 
         // Clean up
         order->nextOrder = nullptr;
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file, for replaying captured data without read() copies.
+// Linux: mmap'ed with MAP_POPULATE (read in and mapped up front, so consumers never wait
+// on disk or take a major fault mid-run) and MADV_SEQUENTIAL.
+// Other platforms: the file is read into memory.
+// Throws std::runtime_error if the file cannot be opened or mapped.
+class MappedFile {
+private:
+    void* mapping = nullptr;
+    size_t mappedBytes = 0;
+    std::vector<std::uint8_t> fallback;
+
+    const std::uint8_t* first = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::uint8_t> bytes() const { return {first, length}; }
+    const std::uint8_t* data() const { return first; }
+    size_t size() const { return length; }
+};
@@ -0,0 +1,145 @@
+#ifndef MATCHING_ENGINE_H
+#define MATCHING_ENGINE_H
+
+#include "Book.h"
+#include "SPSCQueue.h"
+#include "Threading.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Command routed to the shard that owns `symbol` (32 bytes)
+struct EngineCommand {
+    SymbolId symbol;
+    Command command;
+};
+
+// Multi-symbol engine: symbols are partitioned across N shards, each shard is one
+// pinned matching thread that exclusively owns its Books (no locks, no sharing).
+// A single gateway thread routes commands through per-shard SPSC rings.
+template <typename BookT = Book>
+class MatchingEngine {
+private:
+    // Commands applied before the consumer index is published back to the gateway
+    static constexpr size_t DRAIN_BATCH = 64;
+
+    struct Shard {
+        SPSCQueue<EngineCommand> queue;
+        std::thread worker;
+
+        Shard(size_t queueCapacity)
+            : queue(queueCapacity) {}
+    };
+
+    size_t maxOrdersPerSymbol;
+
+    // Indexed by SymbolId; each Book is constructed by its owning shard thread
+    std::vector<std::unique_ptr<BookT>> books;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::atomic<bool> running{false};
+    std::atomic<size_t> shardsReady{0};
+
+    void runShard(size_t shardIdx, int coreId);
+
+public:
+    MatchingEngine(size_t symbolCount, size_t shardCount, size_t maxOrders, size_t queueCapacity = 1 << 16);
+
+    ~MatchingEngine() { stop(); }
+
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    // Spawns one matching thread per shard, shard i pinned to `firstCore + i`.
+    // Returns once every shard has built its Books.
+    void start(int firstCore);
+    // Drains every routed command, then joins all shard threads
+    void stop();
+
+    // Gateway side (single producer). Returns false if the owning shard's ring is full
+    // or `symbol` is not one of this engine's symbols (retrying the latter never succeeds).
+    bool submit(SymbolId symbol, const Command& cmd) {
+        if (symbol >= books.size())
+            return false;
+        return shards[shardFor(symbol)]->queue.push({symbol, cmd});
+    }
+
+    size_t shardFor(SymbolId symbol) const { return symbol % shards.size(); }
+    size_t getShardCount() const { return shards.size(); }
+    size_t getSymbolCount() const { return books.size(); }
+
+    // Only safe to inspect while the engine is stopped
+    BookT& getBook(SymbolId symbol) { return *books[symbol]; }
+};
+
+template <typename BookT>
+MatchingEngine<BookT>::MatchingEngine(size_t symbolCount, size_t shardCount, size_t maxOrders, size_t queueCapacity)
+    : maxOrdersPerSymbol(maxOrders)
+    , books(symbolCount) {
+    if (shardCount == 0)
+        shardCount = 1;
+
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; i++) {
+        shards.push_back(std::make_unique<Shard>(queueCapacity));
+    }
+}
+
+template <typename BookT>
+void MatchingEngine<BookT>::start(int firstCore) {
+    if (running.exchange(true))
+        return;
+
+    shardsReady.store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < shards.size(); i++) {
+        shards[i]->worker = std::thread(&MatchingEngine::runShard, this, i, firstCore + static_cast<int>(i));
+    }
+
+    while (shardsReady.load(std::memory_order_acquire) != shards.size()) {
+        std::this_thread::yield();
+    }
+}
+
+template <typename BookT>
+void MatchingEngine<BookT>::stop() {
+    running.store(false, std::memory_order_release);
+
+    for (auto& shard : shards) {
+        if (shard->worker.joinable())
+            shard->worker.join();
+    }
+}
+
+template <typename BookT>
+void MatchingEngine<BookT>::runShard(size_t shardIdx, int coreId) {
+    pinThreadToCore(coreId);
+
+    // First touch from the pinned thread keeps each Book on the shard's local memory node
+    for (size_t symbol = shardIdx; symbol < books.size(); symbol += shards.size()) {
+        if (!books[symbol])
+            books[symbol] = std::make_unique<BookT>(maxOrdersPerSymbol);
+    }
+    shardsReady.fetch_add(1, std::memory_order_release);
+
+    SPSCQueue<EngineCommand>& queue = shards[shardIdx]->queue;
+    auto apply = [this](const EngineCommand& cmd) { books[cmd.symbol]->process(cmd.command); };
+
+    while (true) {
+        if (queue.consume(apply, DRAIN_BATCH) != 0)
+            continue;
+
+        // Ring is empty: exit only once the gateway has finished and nothing is left
+        if (!running.load(std::memory_order_acquire)) {
+            if (queue.consume(apply, DRAIN_BATCH) == 0)
+                break;
+            continue;
+        }
+
+        cpuRelax();
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef MATCHING_LOOP_H
+#define MATCHING_LOOP_H
+
+#include "Book.h"
+#include "SPSCQueue.h"
+#include "Threading.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+// Default MatchingLoop batch hook: nothing to do between batches
+struct NoBatchHook {
+    void operator()() {}
+};
+
+// Matching-thread driver: owns the consumer side of an ingress ring and
+// busy-polls it on a dedicated core, applying each Command to the Book.
+// The gateway thread is the single producer.
+// `OnBatch` runs on the matching thread after every consumed batch (e.g. to drain an
+// ExecutionBuffer listener, which nothing else would drain while the loop owns the book).
+template <typename BookT, typename OnBatch = NoBatchHook>
+class MatchingLoop {
+private:
+    // Commands applied before the consumer index is published back to the producer
+    static constexpr size_t DRAIN_BATCH = 64;
+
+    BookT& book;
+    SPSCQueue<Command>& queue;
+    [[no_unique_address]] OnBatch onBatch;
+
+    std::atomic<bool> running{false};
+    std::thread worker;
+
+    void run(int coreId) {
+        pinThreadToCore(coreId);
+
+        auto apply = [this](const Command& cmd) { book.process(cmd); };
+
+        while (true) {
+            if (queue.consume(apply, DRAIN_BATCH) != 0) {
+                onBatch();
+                continue;
+            }
+
+            // Ring is empty: exit only once the producer has finished and nothing is left
+            if (!running.load(std::memory_order_acquire)) {
+                if (queue.consume(apply) == 0)
+                    break;
+                onBatch();
+                continue;
+            }
+
+            cpuRelax();
+        }
+    }
+
+public:
+    MatchingLoop(BookT& b, SPSCQueue<Command>& q, OnBatch hook = OnBatch())
+        : book(b)
+        , queue(q)
+        , onBatch(std::move(hook)) {}
+
+    ~MatchingLoop() { stop(); }
+
+    MatchingLoop(const MatchingLoop&) = delete;
+    MatchingLoop& operator=(const MatchingLoop&) = delete;
+
+    // Spawns the matching thread pinned to `coreId`
+    void start(int coreId) {
+        if (running.exchange(true))
+            return;
+
+        worker = std::thread(&MatchingLoop::run, this, coreId);
+    }
+
+    // Drains every command already enqueued, then joins the matching thread
+    void stop() {
+        running.store(false, std::memory_order_release);
+
+        if (worker.joinable())
+            worker.join();
+    }
+};
+
+#endif
@@ -1,9 +1,20 @@
 #pragma once
 
+#include "HugePageAllocator.h"
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <new>
 #include <utility>
+#include <vector>
 
+// Slab allocator with an intrusive LIFO free list.
+//  * Memory comes in fixed-size chunks; when the free list runs dry a new chunk is
+//    added. Existing objects never move, so outstanding pointers stay valid.
+//  * Chunks >= 2MB are backed by huge pages where available (see HugePageAllocator.h)
+//    and are pre-faulted when created, so the hot path never takes a page fault.
+//  * Occupancy / high-water statistics are tracked for capacity planning.
 template <typename T>
 class ObjectPool {
 private:
@@ -15,27 +26,60 @@ private:
         ~Slot() {}
     };
 
-    Slot* pool;
+    std::vector<MemoryRegion> chunks;
     Slot* freeList = nullptr;
-    size_t capacity;
+
+    size_t chunkSlots;
+    size_t capacity = 0;
+    size_t inUse = 0;
+    size_t highWater = 0;
+
+    // Threads a new chunk of at least `slotCount` slots onto the free list (touching every slot)
+    void addChunk(size_t slotCount) {
+        MemoryRegion region = allocateRegion(slotCount * sizeof(Slot), true);
+        chunks.push_back(region);
+
+        Slot* slots = static_cast<Slot*>(region.base);
+        size_t n = region.bytes / sizeof(Slot);
+
+        for (size_t i = 0; i < n - 1; i++) {
+            slots[i].next = &slots[i + 1];
+        }
+        slots[n - 1].next = freeList;
+        freeList = &slots[0];
+
+        capacity += n;
+    }
 
 public:
-    ObjectPool(size_t n)
-        : capacity(n) {
-        pool = static_cast<Slot*>(::operator new[](capacity * sizeof(Slot)));
-        reset();
+    // `n` slots are reserved up front; growth happens in chunks of `growSlots` (default: n)
+    ObjectPool(size_t n, size_t growSlots = 0)
+        : chunkSlots(std::max<size_t>(growSlots ? growSlots : n, 1)) {
+        reserve(n);
+    }
+
+    ~ObjectPool() {
+        for (const MemoryRegion& region : chunks) {
+            releaseRegion(region);
+        }
     }
 
-    ~ObjectPool() { ::operator delete[](pool); }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
 
     template <typename... Args>
     T* acquire(Args&&... args) {
-        if (freeList == nullptr)
-            return nullptr;
+        // Out of slots: grow (cold path) instead of handing out nullptr
+        if (freeList == nullptr) [[unlikely]] {
+            addChunk(chunkSlots);
+        }
 
         Slot* slot = freeList;
         freeList = slot->next;
 
+        inUse++;
+        highWater = std::max(highWater, inUse);
+
         return new (&slot->obj) T(std::forward<Args>(args)...);
     }
 
@@ -48,13 +92,47 @@ public:
         Slot* slot = reinterpret_cast<Slot*>(obj);
         slot->next = freeList;
         freeList = slot;
+
+        inUse--;
+    }
+
+    // Grows until at least `n` slots exist (call at startup to keep growth off the hot path).
+    // The shortfall is added as one chunk, however large.
+    void reserve(size_t n) {
+        if (capacity < n) {
+            addChunk(std::max(n - capacity, chunkSlots));
+        }
     }
 
+    // Re-touches every chunk (e.g. after the OS may have reclaimed idle pages)
+    void prefault() {
+        for (const MemoryRegion& region : chunks) {
+            prefaultRegion(region);
+        }
+    }
+
+    // Returns every slot to the free list (outstanding objects are abandoned, not destroyed)
     void reset() {
-        for (size_t i = 0; i < capacity - 1; i++) {
-            pool[i].next = &(pool[i + 1]);
+        freeList = nullptr;
+        for (const MemoryRegion& region : chunks) {
+            Slot* slots = static_cast<Slot*>(region.base);
+            size_t n = region.bytes / sizeof(Slot);
+
+            for (size_t i = 0; i < n - 1; i++) {
+                slots[i].next = &slots[i + 1];
+            }
+            slots[n - 1].next = freeList;
+            freeList = &slots[0];
         }
-        pool[capacity - 1].next = nullptr;
-        freeList = &(pool[0]);
+        inUse = 0;
+    }
+
+    // --- Statistics ---
+    size_t getCapacity() const { return capacity; }
+    size_t getInUse() const { return inUse; }
+    size_t getHighWater() const { return highWater; }
+    size_t getChunkCount() const { return chunks.size(); }
+    bool isHugePageBacked() const {
+        return !chunks.empty() && std::all_of(chunks.begin(), chunks.end(), [](const MemoryRegion& r) { return r.hugeTlb; });
     }
 };
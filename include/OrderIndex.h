@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Order.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// OrderId -> Order* index policies for BasicBook<Listener, Index>.
+// An index provides find / insert / erase / prefetch; it never owns the Orders.
+
+// Direct indexing: slot = OrderId. One load per lookup, but only valid for small,
+// dense IDs (memory is proportional to the largest ID seen).
+class DirectOrderIndex {
+private:
+    std::vector<Order*> slots;
+
+public:
+    DirectOrderIndex(size_t capacity)
+        : slots(capacity, nullptr) {}
+
+    Order* find(OrderId id) const { return (id < slots.size()) ? slots[id] : nullptr; }
+
+    void insert(OrderId id, Order* order) {
+        // ID past the preallocated range: grow (cold path) instead of writing out of bounds
+        if (id >= slots.size()) [[unlikely]] {
+            slots.resize(std::bit_ceil(id + 1), nullptr);
+        }
+        slots[id] = order;
+    }
+
+    void erase(OrderId id) {
+        if (id < slots.size())
+            slots[id] = nullptr;
+    }
+
+    void prefetch(OrderId id) const {
+        if (id < slots.size())
+            __builtin_prefetch(&slots[id]);
+    }
+
+    // IDs are not known up front, so there is nothing useful to pre-size
+    void reserve(size_t) {}
+
+    void clear() { std::fill(slots.begin(), slots.end(), nullptr); }
+};
+
+// Flat open-addressing hash table with Robin Hood probing, for sparse 64-bit exchange IDs.
+// Maps OrderId -> Value; a value-initialised Value (null pointer, 0) marks an empty slot.
+//  * Slots are 16 bytes (4 per cache line) and preallocated for `capacity` orders at <= 75% load.
+//  * Robin Hood keeps probe sequences short and bounded, so a lookup is usually 1 line.
+//  * Deletion uses backward shifting, so there are no tombstones to degrade probes over a session.
+template <typename Value>
+class HashIndex {
+private:
+    struct Slot {
+        OrderId key;
+        Value value; // Value{} = empty slot
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    // 64 - log2(slots.size()): hash() keeps the top bits of the product
+    unsigned shift;
+    size_t count = 0;
+
+    // Home slot of `id`. Fibonacci hashing: the multiply pushes every input bit into the
+    // top bits, so strided IDs and IDs tagged in their low bits (`seq << 8 | venue`) still
+    // spread over all home slots instead of collapsing onto 1/stride of them.
+    size_t hash(OrderId id) const { return static_cast<size_t>((id * 0x9E3779B97F4A7C15ULL) >> shift); }
+
+    // How far the entry sitting in `pos` is from its home slot
+    size_t probeDistance(const Slot& slot, size_t pos) const { return (pos - hash(slot.key)) & mask; }
+
+    static unsigned shiftFor(size_t slotCount) { return 64 - static_cast<unsigned>(std::countr_zero(slotCount)); }
+
+    static size_t slotsFor(size_t capacity) { return std::bit_ceil(std::max<size_t>(capacity + capacity / 3, 16)); }
+
+    void rehash(size_t slotCount) {
+        std::vector<Slot> old(slotCount, Slot{0, Value{}});
+        old.swap(slots);
+        mask = slots.size() - 1;
+        shift = shiftFor(slots.size());
+        count = 0;
+
+        for (const Slot& slot : old) {
+            if (slot.value != Value{})
+                insert(slot.key, slot.value);
+        }
+    }
+
+public:
+    HashIndex(size_t capacity)
+        : slots(slotsFor(capacity), Slot{0, Value{}})
+        , mask(slots.size() - 1)
+        , shift(shiftFor(slots.size())) {}
+
+    Value find(OrderId id) const {
+        size_t pos = hash(id);
+
+        for (size_t dist = 0;; dist++) {
+            const Slot& slot = slots[pos];
+            if (slot.value == Value{})
+                return Value{};
+            if (slot.key == id)
+                return slot.value;
+            // A resident closer to home than we are means `id` cannot be further along
+            if (probeDistance(slot, pos) < dist)
+                return Value{};
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    void insert(OrderId id, Value value) {
+        // Past the preallocated load factor: rehash (cold path) rather than fail
+        if ((count + 1) * 8 > slots.size() * 7) [[unlikely]] {
+            rehash(slots.size() * 2);
+        }
+
+        Slot carried{id, value};
+        size_t pos = hash(id);
+
+        for (size_t dist = 0;; dist++) {
+            Slot& slot = slots[pos];
+
+            if (slot.value == Value{}) {
+                slot = carried;
+                count++;
+                return;
+            }
+            if (slot.key == carried.key) {
+                slot.value = carried.value;
+                return;
+            }
+
+            // Robin Hood: steal the slot from a richer (closer to home) resident
+            size_t residentDist = probeDistance(slot, pos);
+            if (residentDist < dist) {
+                std::swap(slot, carried);
+                dist = residentDist;
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    void erase(OrderId id) {
+        size_t pos = hash(id);
+
+        for (size_t dist = 0;; dist++) {
+            const Slot& slot = slots[pos];
+            if (slot.value == Value{} || probeDistance(slot, pos) < dist)
+                return;
+            if (slot.key == id)
+                break;
+            pos = (pos + 1) & mask;
+        }
+
+        // Backward shift: pull every displaced follower one slot closer to home
+        size_t next = (pos + 1) & mask;
+        while (slots[next].value != Value{} && probeDistance(slots[next], next) > 0) {
+            slots[pos] = slots[next];
+            pos = next;
+            next = (next + 1) & mask;
+        }
+
+        slots[pos] = Slot{0, Value{}};
+        count--;
+    }
+
+    void prefetch(OrderId id) const { __builtin_prefetch(&slots[hash(id)]); }
+
+    // Sizes the table for `capacity` orders in one rehash (bulk loads)
+    void reserve(size_t capacity) {
+        if (slotsFor(capacity) > slots.size())
+            rehash(slotsFor(capacity));
+    }
+
+    void clear() {
+        std::fill(slots.begin(), slots.end(), Slot{0, Value{}});
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t getSlotCount() const { return slots.size(); }
+
+    // Longest displacement from home over all residents (probe-length diagnostic)
+    size_t getMaxProbeDistance() const {
+        size_t longest = 0;
+        for (size_t pos = 0; pos < slots.size(); pos++) {
+            if (slots[pos].value != Value{})
+                longest = std::max(longest, probeDistance(slots[pos], pos));
+        }
+        return longest;
+    }
+};
+
+using HashOrderIndex = HashIndex<Order*>;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hardware performance counters around a measured region (Linux perf_event_open).
+// All events are opened as one group on the calling thread (user space only), so they
+// are scheduled on the PMU together and their ratios are consistent. Events the CPU or
+// kernel refuses are skipped; with none at all (non-Linux, VM without a virtual PMU,
+// perf_event_paranoid too strict) isAvailable() is false and the caller carries on.
+
+enum class PerfEvent : std::uint8_t {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    DTLB_MISSES,
+    COUNT,
+};
+
+constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::COUNT);
+
+const char* perfEventName(PerfEvent event);
+
+// Counter totals over one or more regions (scaled up if the group was multiplexed)
+struct PerfSample {
+    std::array<std::uint64_t, PERF_EVENT_COUNT> values{};
+    std::array<bool, PERF_EVENT_COUNT> valid{};
+    // Regions accumulated by add()
+    std::uint32_t regions = 0;
+
+    bool has(PerfEvent e) const { return valid[static_cast<size_t>(e)]; }
+    std::uint64_t get(PerfEvent e) const { return values[static_cast<size_t>(e)]; }
+
+    // Accumulates another region (an event stays valid only if every region counted it)
+    void add(const PerfSample& other) {
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            values[i] += other.values[i];
+            valid[i] = (regions == 0 || valid[i]) && other.valid[i];
+        }
+        regions++;
+    }
+};
+
+class PerfCounters {
+private:
+    std::array<int, PERF_EVENT_COUNT> fds;
+    std::array<std::uint64_t, PERF_EVENT_COUNT> ids{};
+    int leader = -1;
+    std::string error;
+
+public:
+    // Opens every event it can; never throws
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool isAvailable() const { return leader >= 0; }
+    // Why no counter could be opened (empty when available)
+    const std::string& getError() const { return error; }
+
+    // Zeroes and starts the group
+    void start();
+    // Stops the group and returns the counts since start()
+    PerfSample stop();
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "Bitmask.h"
+#include "Limit.h"
+#include "ObjectPool.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+// One side of the book, stored as a sliding window of price levels.
+//  * Levels in [base, base + width) live in a dense Limit* array + hierarchical Bitmask
+//    (the cache-resident region around the touch).
+//  * Levels outside the window live in an ordered overflow map (far from the touch, rarely hit).
+//  * recenter() slides the window; only populated levels are moved, so its cost is
+//    proportional to the number of levels, not the window width.
+// Prices are absolute ticks, so any Price < MAX_PRICE can be represented.
+class PriceLadder {
+private:
+    Price base = 0;
+    size_t width;
+
+    // Dense window: index = price - base
+    std::vector<Limit*> window;
+    Bitmask windowMask;
+
+    // Far-away levels (below base or at/above base + width)
+    std::map<Price, Limit*> overflow;
+
+    size_t levelCount = 0;
+
+    // Level storage (sized for a full window, grows in window-sized chunks beyond that)
+    ObjectPool<Limit> limitPool;
+
+    // Scratch space for recenter(), reserved once
+    std::vector<std::pair<Price, Limit*>> displaced;
+
+    std::uint64_t windowEnd() const { return static_cast<std::uint64_t>(base) + width; }
+
+    void place(Price price, Limit* limit) {
+        if (inWindow(price)) {
+            window[price - base] = limit;
+            windowMask.set(price - base);
+        } else {
+            overflow.emplace(price, limit);
+        }
+    }
+
+public:
+    PriceLadder(size_t windowWidth)
+        : width(windowWidth)
+        , window(windowWidth, nullptr)
+        , windowMask(windowWidth)
+        , limitPool(windowWidth) {
+        displaced.reserve(windowWidth);
+    }
+
+    PriceLadder(const PriceLadder&) = delete;
+    PriceLadder& operator=(const PriceLadder&) = delete;
+
+    bool inWindow(Price price) const { return static_cast<Price>(price - base) < width; }
+
+    Limit* find(Price price) const {
+        if (inWindow(price))
+            return window[price - base];
+
+        auto it = overflow.find(price);
+        return (it == overflow.end()) ? nullptr : it->second;
+    }
+
+    // Window-only lookup (nullptr outside the window): never touches the overflow map
+    Limit* peek(Price price) const { return inWindow(price) ? window[price - base] : nullptr; }
+
+    // Cache hint for the window slot of `price` (overflow levels are cold anyway)
+    void prefetch(Price price) const {
+        if (inWindow(price))
+            __builtin_prefetch(&window[price - base]);
+    }
+
+    // Creates an empty level at `price` (must not already exist)
+    Limit* insert(Price price) {
+        Limit* limit = limitPool.acquire(price);
+        place(price, limit);
+        levelCount++;
+        return limit;
+    }
+
+    // Removes and releases the level at `price` (no-op if absent)
+    void erase(Price price) {
+        Limit* limit = nullptr;
+
+        if (inWindow(price)) {
+            limit = window[price - base];
+            window[price - base] = nullptr;
+            windowMask.unset(price - base);
+        } else {
+            auto it = overflow.find(price);
+            if (it != overflow.end()) {
+                limit = it->second;
+                overflow.erase(it);
+            }
+        }
+
+        if (limit) {
+            levelCount--;
+            limitPool.release(limit);
+        }
+    }
+
+    // Lowest populated price >= startPrice, or -1
+    long long scanAsc(Price startPrice) const {
+        if (!overflow.empty() && startPrice < base) {
+            auto it = overflow.lower_bound(startPrice);
+            if (it != overflow.end() && it->first < base)
+                return it->first;
+        }
+
+        std::uint64_t start = std::max(startPrice, base);
+        if (start < windowEnd()) {
+            long long next = windowMask.scanAsc(start - base);
+            if (next != -1)
+                return base + next;
+        }
+
+        if (!overflow.empty()) {
+            auto it = overflow.lower_bound(static_cast<Price>(std::max<std::uint64_t>(startPrice, windowEnd())));
+            if (it != overflow.end())
+                return it->first;
+        }
+
+        return -1;
+    }
+
+    // Highest populated price <= startPrice, or -1
+    long long scanDesc(Price startPrice) const {
+        if (!overflow.empty() && startPrice >= windowEnd()) {
+            auto it = overflow.upper_bound(startPrice);
+            if (it != overflow.begin() && (--it)->first >= windowEnd())
+                return it->first;
+        }
+
+        if (startPrice >= base) {
+            std::uint64_t start = std::min<std::uint64_t>(startPrice, windowEnd() - 1);
+            long long next = windowMask.scanDesc(start - base);
+            if (next != -1)
+                return base + next;
+        }
+
+        if (!overflow.empty() && base > 0) {
+            auto it = overflow.upper_bound(std::min<Price>(startPrice, base - 1));
+            if (it != overflow.begin())
+                return (--it)->first;
+        }
+
+        return -1;
+    }
+
+    // Slides the window so that `center` sits in its middle
+    void recenter(Price center) {
+        std::uint64_t half = width / 2;
+        std::uint64_t maxBase = (MAX_PRICE > width) ? MAX_PRICE - width : 0;
+        Price newBase = static_cast<Price>(std::min<std::uint64_t>(center > half ? center - half : 0, maxBase));
+
+        if (newBase == base)
+            return;
+
+        // 1. Lift every populated window level out
+        displaced.clear();
+        for (long long idx = windowMask.scanAsc(0); idx != -1; idx = windowMask.scanAsc(idx + 1)) {
+            displaced.emplace_back(base + idx, window[idx]);
+            window[idx] = nullptr;
+            windowMask.unset(idx);
+        }
+
+        base = newBase;
+
+        // 2. Pull overflow levels that now fall inside the window
+        auto it = overflow.lower_bound(base);
+        while (it != overflow.end() && it->first < windowEnd()) {
+            window[it->first - base] = it->second;
+            windowMask.set(it->first - base);
+            it = overflow.erase(it);
+        }
+
+        // 3. Re-seat the lifted levels (window if still covered, otherwise overflow)
+        for (const auto& [price, limit] : displaced) {
+            place(price, limit);
+        }
+    }
+
+    template <typename Fn>
+    void forEachLevel(Fn&& fn) const {
+        for (long long idx = windowMask.scanAsc(0); idx != -1; idx = windowMask.scanAsc(idx + 1)) {
+            fn(window[idx]);
+        }
+        for (const auto& [price, limit] : overflow) {
+            fn(limit);
+        }
+    }
+
+    // Drops every level (outstanding Limit pointers become invalid) and resets the window
+    void clear() {
+        for (long long idx = windowMask.scanAsc(0); idx != -1; idx = windowMask.scanAsc(idx + 1)) {
+            window[idx] = nullptr;
+            windowMask.unset(idx);
+        }
+        overflow.clear();
+        limitPool.reset();
+        levelCount = 0;
+        base = 0;
+    }
+
+    bool empty() const { return levelCount == 0; }
+    size_t getLevelCount() const { return levelCount; }
+    Price getBase() const { return base; }
+    size_t getWidth() const { return width; }
+    // Window and level storage (overflow map nodes excluded)
+    size_t getMemoryBytes() const { return window.capacity() * sizeof(Limit*) + limitPool.getCapacity() * sizeof(Limit); }
+};
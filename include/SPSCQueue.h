@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Bounded lock-free Single-Producer / Single-Consumer ring buffer.
+//  * Capacity is rounded up to a power of two so wrapping is a single AND.
+//  * Producer and consumer indices live on separate cache lines (no false sharing).
+//  * Each side caches the other side's index and only re-reads it (a cross-core miss)
+//    when the ring looks full / empty.
+template <typename T>
+class SPSCQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "SPSCQueue records must be trivially copyable");
+
+private:
+    // Read-only after construction
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<T[]> buffer;
+    size_t capacity;
+    size_t mask;
+
+    // Producer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;
+
+    // Consumer cache line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+
+public:
+    SPSCQueue(size_t minCapacity)
+        : buffer(std::make_unique<T[]>(std::bit_ceil(minCapacity < 2 ? 2 : minCapacity)))
+        , capacity(std::bit_ceil(minCapacity < 2 ? 2 : minCapacity))
+        , mask(capacity - 1) {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // --- Producer ---
+
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t - cachedHead == capacity) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == capacity)
+                return false;
+        }
+
+        buffer[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumer ---
+
+    bool pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail)
+                return false;
+        }
+
+        out = buffer[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hands every visible record to `fn` in place, then publishes the new head once.
+    // Returns the number of records consumed.
+    template <typename Fn>
+    size_t consume(Fn&& fn, size_t maxItems = SIZE_MAX) {
+        size_t h = head.load(std::memory_order_relaxed);
+
+        // One producer-index read per batch rather than per record
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (h == cachedTail)
+            return 0;
+
+        size_t available = cachedTail - h;
+        size_t n = available < maxItems ? available : maxItems;
+
+        for (size_t i = 0; i < n; i++) {
+            fn(buffer[(h + i) & mask]);
+        }
+
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // --- Either side (approximate while the other side is running) ---
+
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    size_t size() const {
+        size_t h = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - h;
+    }
+
+    size_t getCapacity() const { return capacity; }
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Book snapshot file: header, then every bid level followed by every ask level, then the
+// pending stops (buy trigger levels, then sell trigger levels). Each level is a
+// SnapshotLevel followed by its orders in FIFO (time-priority) order:
+//
+//   SnapshotHeader
+//   | { SnapshotLevel, SnapshotOrder x level.orderCount } x (bidLevels + askLevels)
+//   | { SnapshotLevel, SnapshotStop x level.orderCount } x (buyStopLevels + sellStopLevels)
+//
+// A stop level's price is its trigger. Records are fixed-size and naturally aligned, so a
+// mapped file is read in place.
+constexpr std::uint64_t SNAPSHOT_MAGIC = 0x485350414E53424FULL; // "OBSNAPSH"
+// v2: pending stops and the last trade price (which decides when they fire)
+constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t orderCount;
+    std::uint32_t bidLevels;
+    std::uint32_t askLevels;
+    Price highestBid;
+    Price lowestAsk;
+    std::uint64_t stopCount;
+    std::uint32_t buyStopLevels;
+    std::uint32_t sellStopLevels;
+    // 0 if nothing has traded
+    Price lastTradePrice;
+    std::uint32_t reserved2;
+};
+
+struct SnapshotLevel {
+    Price price;
+    std::uint32_t orderCount;
+};
+
+struct SnapshotOrder {
+    OrderId id;
+    Quantity qty;
+    std::uint32_t reserved;
+};
+
+// Pending STOP / STOP_LIMIT order (limitPrice is 0 for a plain stop)
+struct SnapshotStop {
+    OrderId id;
+    Quantity qty;
+    Price limitPrice;
+    OrderType type;
+    std::uint8_t reserved[7];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64 && sizeof(SnapshotLevel) == 8 && sizeof(SnapshotOrder) == 16 &&
+              sizeof(SnapshotStop) == 24);
+static_assert(std::is_trivially_copyable_v<SnapshotHeader> && std::is_trivially_copyable_v<SnapshotOrder> &&
+              std::is_trivially_copyable_v<SnapshotStop>);
+
+// Price levels whose queues are walked concurrently when saving
+constexpr size_t SNAPSHOT_LANES = 8;
+// Orders ahead of the current one whose index slots are prefetched when loading
+constexpr size_t SNAPSHOT_PREFETCH = 16;
+
+// Stages levels and orders in a 1MB buffer written out in whole blocks; counts and best
+// prices are patched into the header by close(). Throws std::runtime_error on I/O failure.
+class SnapshotWriter {
+private:
+    std::FILE* file = nullptr;
+    SnapshotHeader header{};
+    std::vector<std::uint8_t> pending;
+
+    void write(const void* data, size_t bytes);
+    void flush();
+
+public:
+    explicit SnapshotWriter(const std::string& path);
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // One level and its queue in FIFO order; all bid levels must precede the first ask level
+    void writeLevel(Side side, Price price, const SnapshotOrder* orders, std::uint32_t orderCount);
+    // One stop trigger level and its queue in FIFO order, after every resting level;
+    // all buy stop levels must precede the first sell stop level
+    void writeStopLevel(Side side, Price trigger, const SnapshotStop* stops, std::uint32_t stopCount);
+
+    // Flushes and finalises the header (idempotent; also run by the destructor)
+    void close(Price highestBid, Price lowestAsk, Price lastTradePrice = 0);
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Pins the calling thread to a CPU core (Linux) or requests performance cores (macOS)
+void pinThreadToCore(int core_id);
+
+// Spin-wait hint: lets the sibling hyperthread run and avoids a memory-order
+// pipeline flush when the busy-poll loop finally observes a change
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Types.h"
+
+#include <functional>
+#include <utility>
+
+// Trade listener policies for BasicBook<Listener>.
+// A listener is any type with `void onTrade(const Trade&)`. The call is made directly
+// on the concrete type, so the compiler can inline it into the fill loop.
+
+// Pure matching: the call and the Trade construction compile away entirely
+struct NoopListener {
+    void onTrade(const Trade&) {}
+};
+
+using TradeCallback = std::function<void(const Trade&)>;
+
+// Type-erased adapter: keeps runtime-swappable callbacks (setTradeCallback) working
+// at the cost of one null check + indirect call per fill
+class CallbackListener {
+private:
+    TradeCallback callback = nullptr;
+
+public:
+    CallbackListener() = default;
+    CallbackListener(TradeCallback cb)
+        : callback(std::move(cb)) {}
+
+    void onTrade(const Trade& trade) {
+        if (callback)
+            callback(trade);
+    }
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Timestamps for in-engine latency instrumentation. On x86 these read the (invariant)
+// time-stamp counter: ~20 cycles, no syscall, no vDSO call. Elsewhere they fall back to
+// steady_clock nanoseconds, so a "tick" is one nanosecond.
+//
+// tscStart()/tscStop() bracket a measured region: the fences keep the region's work from
+// being reordered across the reads (lfence + rdtsc before, rdtscp + lfence after).
+inline std::uint64_t tscStart() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline std::uint64_t tscStop() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int aux;
+    std::uint64_t ticks = __rdtscp(&aux);
+    _mm_lfence();
+    return ticks;
+#else
+    return tscStart();
+#endif
+}
+
+// Nanoseconds per tick, calibrated against steady_clock on first use (~10 ms, once per
+// process; later calls are a load)
+double tscNanosPerTick();
+
+inline double tscToNanos(std::uint64_t ticks) { return ticks * tscNanosPerTick(); }
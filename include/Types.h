@@ -2,10 +2,13 @@
 #define TYPES_H
 
 #include <cstdint>
+#include <cstddef>
+#include <limits>
 
 using Price = std::uint32_t;
 using Quantity = std::uint32_t;
 using OrderId = std::uint64_t;
+using SymbolId = std::uint32_t;
 
 enum class Side : std::uint8_t {
     BUY,
@@ -16,15 +19,46 @@ enum class OrderType : std::uint8_t {
     LIMIT,
     CANCEL,
     MARKET,
+    MODIFY,
+    // Limit order whose unfilled remainder is dropped instead of resting
+    IOC,
+    // Limit order that fills completely or not at all
+    FOK,
+    // Limit order that only rests: rejected if it would cross
+    POST_ONLY,
+    // Held off the book until a trade reaches `stopPrice`, then sent in as a market order
+    STOP,
+    // Same, but sent in as a limit order at `price`
+    STOP_LIMIT,
 };
 
+// Fixed-size inbound command record (24 bytes)
+struct Command {
+    OrderId id;
+    Price price;
+    Quantity qty;
+    OrderType type;
+    Side side;
+    // Trigger price of STOP / STOP_LIMIT (sits in what used to be tail padding)
+    Price stopPrice = 0;
+};
+
+// Execution report for a single fill (32 bytes)
 struct Trade {
     OrderId takerOrderId;
     OrderId makerOrderId;
     Price price;
     Quantity quantity;
+    // Maker quantity left after this fill (0 = maker fully filled)
+    Quantity makerRemaining;
+    // This fill removed the last order resting at `price`
+    bool levelEmptied;
 };
 
-constexpr Price MAX_PRICE = 100'000;
+// Exclusive upper bound on prices; doubles as the "no asks" sentinel
+constexpr Price MAX_PRICE = std::numeric_limits<Price>::max();
+
+// Ticks held in each side's dense, cache-resident window around the touch
+constexpr size_t DEFAULT_LADDER_WIDTH = 4096;
 
 #endif
\ No newline at end of file
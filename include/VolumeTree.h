@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Types.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fenwick (binary indexed) tree over the resting volume of one side's dense price window,
+// kept in step with the Book's level updates (see BasicBook::enableVolumeIndex).
+//  * set() is O(log width): it adds the level's volume delta to log2(width) nodes.
+//  * Prefix sums of volume and of notional, and "how far does quantity X reach", are
+//    O(log width) too, instead of one ladder scan + Limit load per level.
+// Notional is kept relative to the window base ((price - base) * volume) so that it
+// stays exact in 64 bits; callers add base * volume back.
+// The tree covers [base, base + width) only: the Book rebuilds it whenever the ladder's
+// window slides, and walks overflow levels itself.
+class VolumeTree {
+public:
+    // Sums over a prefix of the window
+    struct Sum {
+        std::uint64_t volume = 0;
+        std::uint64_t notional = 0;
+    };
+
+private:
+    Price base = 0;
+    size_t width;
+    // Largest power of two <= width (first step of the descent)
+    size_t topStep;
+
+    // 1-based: node i covers offsets (i - lowbit(i), i]
+    std::vector<Sum> tree;
+    // Current volume per offset (what set() diffs against)
+    std::vector<Quantity> levels;
+
+public:
+    VolumeTree(size_t windowWidth)
+        : width(windowWidth)
+        , topStep(1)
+        , tree(windowWidth + 1)
+        , levels(windowWidth, 0) {
+        while (topStep * 2 <= width) {
+            topStep *= 2;
+        }
+    }
+
+    bool inWindow(Price price) const { return static_cast<Price>(price - base) < width; }
+
+    // Level at `price` now holds `volume` (0: level gone). Prices outside the window are ignored.
+    void set(Price price, Quantity volume) {
+        if (!inWindow(price))
+            return;
+
+        size_t offset = price - base;
+        // Unsigned deltas wrap, the sums they land in never do
+        std::uint64_t delta = static_cast<std::uint64_t>(volume) - levels[offset];
+        levels[offset] = volume;
+        for (size_t i = offset + 1; i <= width; i += i & (~i + 1)) {
+            tree[i].volume += delta;
+            tree[i].notional += delta * offset;
+        }
+    }
+
+    // Empties the tree and moves it to [newBase, newBase + width). Follow with load() for
+    // each populated level and one build().
+    void reset(Price newBase) {
+        base = newBase;
+        std::fill(levels.begin(), levels.end(), 0);
+    }
+
+    void load(Price price, Quantity volume) {
+        if (inWindow(price))
+            levels[price - base] = volume;
+    }
+
+    // Builds every node from the loaded levels in O(width)
+    void build() {
+        for (size_t i = 1; i <= width; i++) {
+            tree[i] = {levels[i - 1], static_cast<std::uint64_t>(levels[i - 1]) * (i - 1)};
+        }
+        for (size_t i = 1; i <= width; i++) {
+            size_t parent = i + (i & (~i + 1));
+            if (parent <= width) {
+                tree[parent].volume += tree[i].volume;
+                tree[parent].notional += tree[i].notional;
+            }
+        }
+    }
+
+    // Sums over offsets [0, n)
+    Sum prefix(size_t n) const {
+        Sum sum;
+        for (size_t i = n; i > 0; i -= i & (~i + 1)) {
+            sum.volume += tree[i].volume;
+            sum.notional += tree[i].notional;
+        }
+        return sum;
+    }
+
+    Sum total() const { return prefix(width); }
+
+    // Largest n with prefix(n).volume <= limit. When n < width, offset n is the level
+    // where cumulative volume first exceeds `limit`.
+    size_t upperBound(std::uint64_t limit) const {
+        size_t pos = 0;
+        for (size_t step = topStep; step > 0; step /= 2) {
+            if (pos + step <= width && tree[pos + step].volume <= limit) {
+                pos += step;
+                limit -= tree[pos].volume;
+            }
+        }
+        return pos;
+    }
+
+    Quantity getLevel(Price price) const { return inWindow(price) ? levels[price - base] : 0; }
+    Price getBase() const { return base; }
+    size_t getWidth() const { return width; }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Multi-word scans over arrays of 64-bit words: the index of the first (last) non-zero
+// word in [begin, end), or -1. Bitmask can use them to look past an empty word without
+// climbing its summary hierarchy (see ORDERBOOK_SIMD_WORD_SCAN).
+// The kernel is chosen at build time (the project compiles with -march=native):
+//  * AVX-512F: 8 words per vptestmq, the lane mask goes straight to tzcnt / lzcnt.
+//  * AVX2: 4 words per vptest; a hit is narrowed with a compare + movemask.
+//  * Scalar: one word per iteration (portable fallback, and the tail of the others).
+// Loads are unaligned and never read outside [begin, end).
+
+inline long long firstNonZeroWordScalar(const std::uint64_t* words, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        if (words[i] != 0)
+            return static_cast<long long>(i);
+    }
+    return -1;
+}
+
+inline long long lastNonZeroWordScalar(const std::uint64_t* words, size_t begin, size_t end) {
+    for (size_t i = end; i > begin; i--) {
+        if (words[i - 1] != 0)
+            return static_cast<long long>(i - 1);
+    }
+    return -1;
+}
+
+#if defined(__AVX2__)
+// Bit i set = lane i of `v` is non-zero
+inline unsigned nonZeroLanesAvx2(__m256i v) {
+    __m256i zero = _mm256_cmpeq_epi64(v, _mm256_setzero_si256());
+    return ~static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(zero))) & 0xFu;
+}
+
+inline long long firstNonZeroWordAvx2(const std::uint64_t* words, size_t begin, size_t end) {
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        if (!_mm256_testz_si256(v, v))
+            return static_cast<long long>(i + __builtin_ctz(nonZeroLanesAvx2(v)));
+    }
+    return firstNonZeroWordScalar(words, i, end);
+}
+
+inline long long lastNonZeroWordAvx2(const std::uint64_t* words, size_t begin, size_t end) {
+    size_t i = end;
+    for (; i >= begin + 4; i -= 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i - 4));
+        if (!_mm256_testz_si256(v, v))
+            return static_cast<long long>(i - 4 + 31 - __builtin_clz(nonZeroLanesAvx2(v)));
+    }
+    return lastNonZeroWordScalar(words, begin, i);
+}
+#endif
+
+#if defined(__AVX512F__)
+inline long long firstNonZeroWordAvx512(const std::uint64_t* words, size_t begin, size_t end) {
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m512i v = _mm512_loadu_si512(words + i);
+        unsigned lanes = _mm512_test_epi64_mask(v, v);
+        if (lanes)
+            return static_cast<long long>(i + __builtin_ctz(lanes));
+    }
+    return firstNonZeroWordScalar(words, i, end);
+}
+
+inline long long lastNonZeroWordAvx512(const std::uint64_t* words, size_t begin, size_t end) {
+    size_t i = end;
+    for (; i >= begin + 8; i -= 8) {
+        __m512i v = _mm512_loadu_si512(words + i - 8);
+        unsigned lanes = _mm512_test_epi64_mask(v, v);
+        if (lanes)
+            return static_cast<long long>(i - 8 + 31 - __builtin_clz(lanes));
+    }
+    return lastNonZeroWordScalar(words, begin, i);
+}
+#endif
+
+#if defined(__AVX512F__)
+constexpr const char* WORD_SCAN_KERNEL = "avx512";
+// Words one vector test covers
+constexpr size_t WORD_SCAN_WIDTH = 8;
+#elif defined(__AVX2__)
+constexpr const char* WORD_SCAN_KERNEL = "avx2";
+constexpr size_t WORD_SCAN_WIDTH = 4;
+#else
+constexpr const char* WORD_SCAN_KERNEL = "scalar";
+constexpr size_t WORD_SCAN_WIDTH = 1;
+#endif
+
+inline long long firstNonZeroWord(const std::uint64_t* words, size_t begin, size_t end) {
+#if defined(__AVX512F__)
+    return firstNonZeroWordAvx512(words, begin, end);
+#elif defined(__AVX2__)
+    return firstNonZeroWordAvx2(words, begin, end);
+#else
+    return firstNonZeroWordScalar(words, begin, end);
+#endif
+}
+
+inline long long lastNonZeroWord(const std::uint64_t* words, size_t begin, size_t end) {
+#if defined(__AVX512F__)
+    return lastNonZeroWordAvx512(words, begin, end);
+#elif defined(__AVX2__)
+    return lastNonZeroWordAvx2(words, begin, end);
+#else
+    return lastNonZeroWordScalar(words, begin, end);
+#endif
+}
@@ -1,65 +1,100 @@
 #include "Book.h"
+#include "CommandLog.h"
+#include "CompactBook.h"
+#include "Journal.h"
+#include "MatchingEngine.h"
+#include "MatchingLoop.h"
+#include "PerfCounters.h"
+#include "SPSCQueue.h"
+#include "Threading.h"
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <numeric>
-#include <pthread.h>
 #include <random>
+#include <sstream>
+#include <span>
+#include <thread>
 #include <vector>
 
-#ifdef __linux__
-#include <sched.h>
-#include <unistd.h>
-#endif
-
 const int ORDER_COUNT = 2'000'000;
-const int MAX_ORDERS = 10'000'000;
 const int ITERATIONS = 10;
+const size_t INGRESS_RING_SIZE = 1 << 16;
+const int MATCHING_CORE = 1;
+const size_t REPORT_BATCH = 64;
+const int SCALING_SYMBOLS = 16;
+const int SCALING_ORDERS_PER_SYMBOL = 250'000;
 
-static std::int64_t timestamps[MAX_ORDERS + 1];
+// --perf: hardware counters around each timed phase (nullptr when off or unavailable)
+static PerfCounters* perf = nullptr;
 
-struct OrderAction {
-    OrderId id;
-    Price price;
-    Quantity qty;
-    OrderType type;
-    Side side;
-};
+// IPC and cycles / instructions / misses per operation for one or more timed phases
+std::string describePerf(const PerfSample& sample, std::uint64_t ops) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+
+    if (sample.has(PerfEvent::CYCLES) && sample.has(PerfEvent::INSTRUCTIONS) && sample.get(PerfEvent::CYCLES) > 0) {
+        out << "IPC " << static_cast<double>(sample.get(PerfEvent::INSTRUCTIONS)) / sample.get(PerfEvent::CYCLES);
+    }
+    for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+        auto event = static_cast<PerfEvent>(i);
+        if (!sample.has(event) || ops == 0)
+            continue;
+        if (out.tellp() > 0)
+            out << " | ";
+        out << perfEventName(event) << " " << static_cast<double>(sample.get(event)) / ops << "/op";
+    }
+
+    std::string text = out.str();
+    return text.empty() ? "[no counters]" : text;
+}
 
-void pinThreadToCore([[maybe_unused]] int core_id) {
-#if defined(__linux__)
-    // LINUX: Strict Pinning (Locks thread to specific CPU ID)
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(core_id, &cpuset);
-
-    pthread_t current_thread = pthread_self();
-    int rc = pthread_setaffinity_np(current_thread, sizeof(cpu_set_t), &cpuset);
-
-    if (rc != 0) {
-        std::cerr << "[Linux] Warning: Failed to pin to Core " << core_id << "\n";
-    } else {
-        std::cout << "[Linux] Optimization: Thread pinned to Core " << core_id << "\n";
-    }
-#elif defined(__APPLE__)
-    // Hints scheduler to use performance cores over efficiency cores
-    pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
-    std::cout << "[macOS] Optimization: QoS set to USER_INTERACTIVE (Performance Cores)\n";
-#else
-    // WINDOWS / OTHER
-    std::cout << "[System] Optimization: Pinning not supported on this OS.\n";
-#endif
+static std::int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
 }
 
+// Enqueue-to-trade observer for --pipeline --latency: the gateway stamps each command as it
+// is pushed, the matching thread records (now - stamp) for the taker of every fill. This
+// covers the hand-off, queueing in the ring and matching; a concrete listener type, so the
+// call inlines into the fill loop.
+struct TradeLatencyListener {
+    const std::vector<std::int64_t>* submitted;
+    LatencyHistogram* histogram;
+
+    void onTrade(const Trade& t) {
+        std::int64_t start = (*submitted)[t.takerOrderId];
+        if (start > 0)
+            histogram->record(static_cast<std::uint64_t>(nowNanos() - start));
+    }
+};
+
 class BenchmarkRunner {
 private:
-    std::vector<long long> latencies;
     bool measureLatency = false;
+    bool pipelined = false;
+    bool batchedReports = false;
+    // Keeps drained reports observable so the drain is not optimised out
+    std::uint64_t publishedQty = 0;
+
+    std::vector<double> statsThroughput;
+    // Per-operation latency accumulated over every run (in-engine TSC histograms)
+    OperationLatency latency;
+    // --pipeline --latency: gateway timestamp per order ID, and enqueue-to-trade latency
+    // in nanoseconds (this run / every run)
+    std::vector<std::int64_t> submitTimes;
+    LatencyHistogram tradeLatency, tradeLatencyTotal;
+    // Hardware counters accumulated over every run (--perf)
+    PerfSample counters;
+    std::uint64_t countedOps = 0;
 
-    std::vector<double> statsThroughput, statsP50, statsP90, statsP99, statsMax;
+    // Order pool occupancy from the last run
+    size_t poolHighWater = 0, poolCapacity = 0, poolChunks = 0;
+    bool poolHugePages = false;
 
     std::string formatNum(long long n) {
         std::string s = std::to_string(n);
@@ -73,32 +108,38 @@ private:
 
 public:
     void setMeasureLatency(bool val) { measureLatency = val; }
+    void setPipelined(bool val) { pipelined = val; }
+    void setBatchedReports(bool val) { batchedReports = val; }
 
-    void run(const std::vector<OrderAction>& actions, int iteration) {
-        Book book(ORDER_COUNT + 1000);
-        ;
-
-        // Trade Callback for Tick to Trade Latency
-        if (measureLatency) {
-            latencies.clear();
-            latencies.reserve(actions.size());
-
-            book.setTradeCallback([&](const Trade& t) {
-                auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                               std::chrono::steady_clock::now().time_since_epoch())
-                               .count();
-
-                std::int64_t start = timestamps[t.takerOrderId];
+    void run(const std::vector<Command>& actions, int iteration) {
+        if (batchedReports) {
+            BasicBook<ExecutionBuffer> book(ORDER_COUNT + 1000);
+            book.enableLatencyStats(measureLatency);
+            execute(book, actions, iteration);
+        } else if (pipelined && measureLatency) {
+            OrderId maxId = 0;
+            for (const auto& order : actions) {
+                maxId = std::max(maxId, order.id);
+            }
+            submitTimes.assign(maxId + 1, 0);
+            tradeLatency.reset();
 
-                if (start > 0) {
-                    latencies.push_back(now - start);
-                }
-            });
+            BasicBook<TradeLatencyListener> book(ORDER_COUNT + 1000, DEFAULT_LADDER_WIDTH,
+                                                 TradeLatencyListener{&submitTimes, &tradeLatency});
+            book.enableLatencyStats(true);
+            execute(book, actions, iteration);
+        } else {
+            BasicBook<NoopListener> book(ORDER_COUNT + 1000);
+            book.enableLatencyStats(measureLatency);
+            execute(book, actions, iteration);
         }
+    }
 
+    template <typename BookT>
+    void execute(BookT& book, const std::vector<Command>& actions, int iteration) {
         // --- Warmup Phase ---
         {
-            Book warmupBook(100000);
+            BasicBook<NoopListener> warmupBook(100000);
 
             for (int i = 0; i < 100'000; ++i) {
                 warmupBook.addLimitOrder(i, 10000 + (i % 10), 1, Side::BUY);
@@ -109,28 +150,67 @@ public:
         // --- Benchmark Phase ---
         auto startTime = std::chrono::steady_clock::now();
 
-        for (const auto& order : actions) {
-            if (measureLatency) {
-                timestamps[order.id] = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                           std::chrono::steady_clock::now().time_since_epoch())
-                                           .count();
+        if (pipelined) {
+            // Gateway (this thread) -> SPSC ring -> Matching thread
+            SPSCQueue<Command> ingress(INGRESS_RING_SIZE);
+            auto publish = [this, &book]() {
+                // --reports: the matching thread publishes after each ring batch (<= 64 commands)
+                if constexpr (std::is_same_v<BookT, BasicBook<ExecutionBuffer>>)
+                    book.getListener().drain([&](std::span<const Trade> fills) { publishedQty += fills.back().quantity; });
+            };
+            MatchingLoop matcher(book, ingress, publish);
+            matcher.start(MATCHING_CORE);
+
+            startTime = std::chrono::steady_clock::now();
+            if (perf)
+                perf->start();
+
+            // Stamped before the push, whose release publishes it to the matching thread
+            const bool stamp = !submitTimes.empty();
+            for (const auto& order : actions) {
+                if (stamp)
+                    submitTimes[order.id] = nowNanos();
+                while (!ingress.push(order)) {
+                    cpuRelax();
+                }
             }
 
-            switch (order.type) {
-            case OrderType::LIMIT:
-                book.addLimitOrder(order.id, order.price, order.qty, order.side);
-                break;
-            case OrderType::CANCEL:
-                book.cancelOrder(order.id);
-                break;
-            case OrderType::MARKET:
-                book.addMarketOrder(order.id, order.qty, order.side);
-                break;
+            matcher.stop();
+        } else if constexpr (std::is_same_v<BookT, BasicBook<ExecutionBuffer>>) {
+            // Publisher drains the execution buffer once per batch of orders
+            ExecutionBuffer& reports = book.getListener();
+            size_t pending = 0;
+            if (perf)
+                perf->start();
+
+            for (const auto& order : actions) {
+                book.process(order);
+
+                if (++pending == REPORT_BATCH) {
+                    reports.drain([&](std::span<const Trade> fills) { publishedQty += fills.back().quantity; });
+                    pending = 0;
+                }
+            }
+            reports.drain([&](std::span<const Trade> fills) { publishedQty += fills.back().quantity; });
+        } else {
+            if (perf)
+                perf->start();
+            for (const auto& order : actions) {
+                book.process(order);
             }
         }
 
+        PerfSample sample;
+        if (perf)
+            sample = perf->stop();
         auto endTime = std::chrono::steady_clock::now();
 
+        const auto& pool = book.getOrderPool();
+        poolHighWater = pool.getHighWater();
+        poolCapacity = pool.getCapacity();
+        poolChunks = pool.getChunkCount();
+        poolHugePages = pool.isHugePageBacked();
+
         // --- Reporting ---
 
         // Throughput
@@ -143,28 +223,31 @@ public:
                   << duration.count() << "s"
                   << " | Tput: " << std::setw(9) << tput << " ops/s";
 
-        // Latency
-        if (measureLatency && !latencies.empty()) {
-            std::sort(latencies.begin(), latencies.end());
-
-            size_t n = latencies.size();
-            long long p50 = latencies[n * 0.50];
-            long long p90 = latencies[n * 0.90];
-            long long p99 = latencies[n * 0.99];
-            long long maxLat = latencies.back();
-
-            statsP50.push_back(p50);
-            statsP90.push_back(p90);
-            statsP99.push_back(p99);
-            statsMax.push_back(maxLat);
-
-            std::cout << " | Latency(ns) [Median: " << p50 << " | P90: " << p90 << " | P99: " << p99
-                      << " | Max: " << maxLat << "]";
+        // Latency (every command, all operation types)
+        if (const OperationLatency* stats = book.getLatencyStats()) {
+            LatencyHistogram all;
+            for (size_t op = 0; op < static_cast<size_t>(LatencyOp::COUNT); op++) {
+                all.merge((*stats)[static_cast<LatencyOp>(op)]);
+            }
+            latency.merge(*stats);
 
-        } else if (measureLatency) {
-            std::cout << " | [No Trades Occurred]";
+            auto ns = [](std::uint64_t ticks) { return static_cast<long long>(tscToNanos(ticks)); };
+            std::cout << " | Latency(ns) [Median: " << ns(all.percentile(0.50)) << " | P90: " << ns(all.percentile(0.90))
+                      << " | P99: " << ns(all.percentile(0.99)) << " | Max: " << ns(all.getMax()) << "]";
+        }
+        if constexpr (std::is_same_v<BookT, BasicBook<TradeLatencyListener>>) {
+            tradeLatencyTotal.merge(tradeLatency);
+            std::cout << " | Enqueue->Trade(ns) [Median: " << tradeLatency.percentile(0.50)
+                      << " | P99: " << tradeLatency.percentile(0.99) << " | Max: " << tradeLatency.getMax() << "]";
         }
         std::cout << '\n';
+
+        if (perf) {
+            counters.add(sample);
+            countedOps += actions.size();
+            // Pipelined: the counters follow this (gateway) thread, not the matcher
+            std::cout << "             " << (pipelined ? "gateway " : "") << describePerf(sample, actions.size()) << '\n';
+        }
     }
 
     void printSummary() {
@@ -184,32 +267,62 @@ public:
         std::cout << "============================================\n";
         std::cout << "Orders Per Run    : " << formatNum(ORDER_COUNT) << " Orders \n";
         std::cout << "Total Runs        : " << statsThroughput.size() << "\n";
+        std::cout << "Mode              : " << (pipelined ? "Gateway -> SPSC Ring -> Matcher" : "Single Thread")
+                  << (batchedReports ? " + Batched Execution Reports" : "") << "\n";
         std::cout << "Avg Throughput    : " << formatNum(avgTput) << " ops/sec\n";
+        std::cout << "Order Pool Peak   : " << formatNum(poolHighWater) << " / " << formatNum(poolCapacity) << " slots ("
+                  << poolChunks << " chunk(s), " << (poolHugePages ? "hugetlb" : "THP/4K") << ")\n";
+        if (perf) {
+            std::cout << "Counters          : " << describePerf(counters, countedOps) << "\n";
+        }
 
-        if (measureLatency && !statsP50.empty()) {
-            long long avgP50 = static_cast<long long>(computeAvg(statsP50));
-            long long avgP90 = static_cast<long long>(computeAvg(statsP90));
-            long long avgP99 = static_cast<long long>(computeAvg(statsP99));
-            long long avgMax = static_cast<long long>(computeAvg(statsMax));
+        if (measureLatency) {
+            auto ns = [](std::uint64_t ticks) { return static_cast<long long>(tscToNanos(ticks)); };
 
             std::cout << "--------------------------------------------\n";
-            std::cout << "P50 Latency   : " << formatNum(avgP50) << " ns\n";
-            std::cout << "P90 Latency   : " << formatNum(avgP90) << " ns\n";
-            std::cout << "P99 Latency   : " << formatNum(avgP99) << " ns\n";
-            std::cout << "Max Latency   : " << formatNum(avgMax) << " ns\n";
+            std::cout << "Latency (ns)       Count     P50     P99   P99.9       Max\n";
+            for (size_t op = 0; op < static_cast<size_t>(LatencyOp::COUNT); op++) {
+                const LatencyHistogram& h = latency[static_cast<LatencyOp>(op)];
+                if (h.getCount() == 0)
+                    continue;
+                std::cout << std::left << std::setw(14) << latencyOpName(static_cast<LatencyOp>(op)) << std::right
+                          << std::setw(10) << h.getCount() << std::setw(8) << ns(h.percentile(0.50)) << std::setw(8)
+                          << ns(h.percentile(0.99)) << std::setw(8) << ns(h.percentile(0.999)) << std::setw(10)
+                          << ns(h.getMax()) << "\n";
+            }
+            // End to end across both threads (the rows above are matching-thread service time)
+            if (tradeLatencyTotal.getCount() > 0) {
+                const LatencyHistogram& h = tradeLatencyTotal;
+                auto num = [&](std::uint64_t v) { return formatNum(static_cast<long long>(v)); };
+                std::cout << "--------------------------------------------\n";
+                std::cout << "Enqueue -> Trade (gateway push to fill, " << num(h.getCount()) << " fills)\n";
+                std::cout << "P50 Latency   : " << num(h.percentile(0.50)) << " ns\n";
+                std::cout << "P99 Latency   : " << num(h.percentile(0.99)) << " ns\n";
+                std::cout << "P99.9 Latency : " << num(h.percentile(0.999)) << " ns\n";
+                std::cout << "Max Latency   : " << num(h.getMax()) << " ns\n";
+            }
         }
         std::cout << "============================================\n";
     }
 };
 
-std::vector<OrderAction> pregenerate(int count) {
-    std::vector<OrderAction> actions;
+// Command-type weights for pregenerate(): Limit / Cancel / Market / Modify
+struct WorkloadMix {
+    double limit, cancel, market, modify;
+};
+
+// 70% Limit Order, 25 Cancel Order, 5 Market Order
+constexpr WorkloadMix STANDARD_MIX{70, 25, 5, 0};
+// Quote-update heavy: most traffic re-sizes or re-prices resting orders
+constexpr WorkloadMix MODIFY_MIX{40, 10, 5, 45};
+
+std::vector<Command> pregenerate(int count, unsigned seed = 42, WorkloadMix mix = STANDARD_MIX) {
+    std::vector<Command> actions;
     actions.reserve(count);
     // Seed RNG
-    std::mt19937 rng(42);
+    std::mt19937 rng(seed);
 
-    // 70% Limit Order, 25 Cancel Order, 5 Market Order
-    std::discrete_distribution<int> typeDist({70, 25, 5});
+    std::discrete_distribution<int> typeDist({mix.limit, mix.cancel, mix.market, mix.modify});
     // Range from [$99.70, $100.30]
     std::normal_distribution<double> priceDist(10000.0, 100.0);
     // 50/50 Buy/Sell
@@ -217,7 +330,8 @@ std::vector<OrderAction> pregenerate(int count) {
     // Skewed right (close to real-world)
     std::lognormal_distribution<double> qtyDist(3.0, 0.5);
 
-    std::vector<OrderId> activeIds;
+    // Orders as last submitted (may since have been filled; cancelling those is a no-op)
+    std::vector<Command> activeOrders;
     OrderId curId = 1;
 
     for (int i = 0; i < count; i++) {
@@ -225,49 +339,720 @@ std::vector<OrderAction> pregenerate(int count) {
         Side side = (sideDist(rng) == 0) ? Side::BUY : Side::SELL;
         Quantity qty = static_cast<Quantity>(std::max(1.0, qtyDist(rng)));
 
-        if (type == OrderType::LIMIT || activeIds.empty()) {
+        if (type == OrderType::LIMIT || activeOrders.empty()) {
             // Limit Order
             Price p = static_cast<Price>(priceDist(rng));
             actions.push_back({curId, p, qty, OrderType::LIMIT, side});
-            activeIds.push_back(curId++);
+            activeOrders.push_back(actions.back());
+            curId++;
         } else if (type == OrderType::MARKET) {
             // Market Order
             actions.push_back({curId++, 0, qty, type, side});
         } else if (type == OrderType::CANCEL) {
             // Cancel Order
-            size_t idx = std::uniform_int_distribution<size_t>(0, activeIds.size() - 1)(rng);
-            actions.push_back({activeIds[idx], 0, 0, OrderType::CANCEL, Side::BUY});
+            size_t idx = std::uniform_int_distribution<size_t>(0, activeOrders.size() - 1)(rng);
+            actions.push_back({activeOrders[idx].id, 0, 0, OrderType::CANCEL, Side::BUY});
+
+            activeOrders[idx] = activeOrders.back();
+            activeOrders.pop_back();
+        } else if (type == OrderType::MODIFY) {
+            // Modify Order: half size-downs in place, half re-prices
+            size_t idx = std::uniform_int_distribution<size_t>(0, activeOrders.size() - 1)(rng);
+            Command& target = activeOrders[idx];
 
-            activeIds[idx] = activeIds.back();
-            activeIds.pop_back();
+            if (sideDist(rng) == 0) {
+                target.qty = std::max<Quantity>(1, target.qty / 2);
+            } else {
+                target.price = static_cast<Price>(priceDist(rng));
+                target.qty = qty;
+            }
+            actions.push_back({target.id, target.price, target.qty, OrderType::MODIFY, target.side});
         }
     }
 
     return actions;
 }
 
+// Multi-symbol workload routed through MatchingEngine with 1..N shards.
+// Core 0 runs the gateway, shard i runs on core 1 + i.
+void runScalingBenchmark() {
+    unsigned hw = std::thread::hardware_concurrency();
+    size_t maxShards = (hw > 1) ? hw - 1 : 1;
+
+    std::cout << "Pre-generating " << SCALING_SYMBOLS << " symbols x " << SCALING_ORDERS_PER_SYMBOL << " actions...\n";
+
+    // Interleave per-symbol flows round-robin so every shard sees steady traffic
+    std::vector<std::vector<Command>> flows;
+    for (int s = 0; s < SCALING_SYMBOLS; s++) {
+        flows.push_back(pregenerate(SCALING_ORDERS_PER_SYMBOL, 42 + s));
+    }
+
+    std::vector<EngineCommand> routed;
+    routed.reserve(static_cast<size_t>(SCALING_SYMBOLS) * SCALING_ORDERS_PER_SYMBOL);
+    for (int i = 0; i < SCALING_ORDERS_PER_SYMBOL; i++) {
+        for (int s = 0; s < SCALING_SYMBOLS; s++) {
+            routed.push_back({static_cast<SymbolId>(s), flows[s][i]});
+        }
+    }
+
+    std::cout << "\n============================================\n";
+    std::cout << "          MULTI-SYMBOL SCALING              \n";
+    std::cout << "============================================\n";
+
+    double baseline = 0;
+    for (size_t shards = 1; shards <= maxShards; shards++) {
+        std::vector<double> runs;
+
+        for (int iter = 0; iter < ITERATIONS; iter++) {
+            MatchingEngine<BasicBook<NoopListener>> engine(SCALING_SYMBOLS, shards, SCALING_ORDERS_PER_SYMBOL + 1000);
+            engine.start(MATCHING_CORE);
+
+            auto startTime = std::chrono::steady_clock::now();
+
+            for (const auto& cmd : routed) {
+                while (!engine.submit(cmd.symbol, cmd.command)) {
+                    cpuRelax();
+                }
+            }
+            engine.stop();
+
+            std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+            runs.push_back(routed.size() / duration.count());
+        }
+
+        double avg = std::reduce(runs.begin(), runs.end(), 0.0) / runs.size();
+        if (shards == 1)
+            baseline = avg;
+
+        std::cout << "Shards: " << std::setw(2) << shards << " | Tput: " << std::setw(11)
+                  << static_cast<long long>(avg) << " ops/s | Speedup: " << std::fixed << std::setprecision(2)
+                  << (avg / baseline) << "x\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Replays `actions` once on a fresh BookT and returns ops/sec (adding to `counters`
+// under --perf)
+template <typename BookT>
+double measureThroughput(const std::vector<Command>& actions, PerfSample* counters = nullptr) {
+    BookT book(ORDER_COUNT + 1000);
+
+    if (perf)
+        perf->start();
+    auto startTime = std::chrono::steady_clock::now();
+    for (const auto& order : actions) {
+        book.process(order);
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+    if (perf) {
+        PerfSample sample = perf->stop();
+        if (counters)
+            counters->add(sample);
+    }
+
+    return actions.size() / duration.count();
+}
+
+// Order-index comparison: dense sequential IDs (direct vector vs hash table) and
+// sparse 64-bit exchange-style IDs (hash table only; a direct vector cannot hold them).
+void runIndexBenchmark(const std::vector<Command>& actions) {
+    // Odd-multiplier scramble is a bijection on 64-bit IDs, so the flow is unchanged
+    std::vector<Command> sparse = actions;
+    for (auto& cmd : sparse) {
+        cmd.id = (cmd.id * 0x9E3779B97F4A7C15ULL) ^ 0x5DEECE66DULL;
+    }
+    // Sequence number with a venue tag in the low byte: all-zero low bits except the tag
+    // is the pattern a weak (identity-style) hash collapses onto a few home slots
+    std::vector<Command> strided = actions;
+    for (auto& cmd : strided) {
+        cmd.id = (cmd.id << 8) | (cmd.id % 4);
+    }
+
+    std::vector<double> direct, hashDense, hashSparse, hashStrided;
+    PerfSample directPerf, densePerf, sparsePerf, stridedPerf;
+    for (int i = 0; i < ITERATIONS; i++) {
+        direct.push_back(measureThroughput<BasicBook<NoopListener, DirectOrderIndex>>(actions, &directPerf));
+        hashDense.push_back(measureThroughput<BasicBook<NoopListener, HashOrderIndex>>(actions, &densePerf));
+        hashSparse.push_back(measureThroughput<BasicBook<NoopListener, HashOrderIndex>>(sparse, &sparsePerf));
+        hashStrided.push_back(measureThroughput<BasicBook<NoopListener, HashOrderIndex>>(strided, &stridedPerf));
+    }
+    const std::uint64_t totalOps = actions.size() * ITERATIONS;
+
+    auto avg = [](const std::vector<double>& v) { return static_cast<long long>(std::reduce(v.begin(), v.end(), 0.0) / v.size()); };
+
+    std::cout << "\n============================================\n";
+    std::cout << "           ORDER INDEX COMPARISON           \n";
+    std::cout << "============================================\n";
+    std::cout << "Direct Vector (dense IDs)  : " << std::setw(11) << avg(direct) << " ops/sec\n";
+    std::cout << "Robin Hood    (dense IDs)  : " << std::setw(11) << avg(hashDense) << " ops/sec\n";
+    std::cout << "Robin Hood    (sparse IDs) : " << std::setw(11) << avg(hashSparse) << " ops/sec\n";
+    std::cout << "Robin Hood    (strided IDs): " << std::setw(11) << avg(hashStrided) << " ops/sec\n";
+    if (perf) {
+        std::cout << "--------------------------------------------\n";
+        std::cout << "Direct Vector (dense)  : " << describePerf(directPerf, totalOps) << "\n";
+        std::cout << "Robin Hood    (dense)  : " << describePerf(densePerf, totalOps) << "\n";
+        std::cout << "Robin Hood    (sparse) : " << describePerf(sparsePerf, totalOps) << "\n";
+        std::cout << "Robin Hood    (strided): " << describePerf(stridedPerf, totalOps) << "\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Ladder policy comparison: pooled Limit* window (PriceLadder) vs inline level headers
+// (FlatPriceLadder), on the standard flow and on touch churn where every command
+// creates or drops a level
+void runLadderBenchmark(const std::vector<Command>& actions) {
+    using PooledBook = BasicBook<NoopListener, HashOrderIndex, PriceLadder>;
+    using FlatBook = BasicBook<NoopListener, HashOrderIndex, FlatPriceLadder>;
+
+    // A floor bid, then add + cancel of a one-order level just above it
+    std::vector<Command> churn;
+    churn.push_back({0, 1'000, 1, OrderType::LIMIT, Side::BUY});
+    for (OrderId id = 1; churn.size() < actions.size(); id++) {
+        churn.push_back({id, 1'001 + static_cast<Price>(id % 8), 1, OrderType::LIMIT, Side::BUY});
+        churn.push_back({id, 0, 0, OrderType::CANCEL, Side::BUY});
+    }
+
+    std::vector<double> pooled, flat, pooledChurn, flatChurn;
+    PerfSample pooledPerf, flatPerf, pooledChurnPerf, flatChurnPerf;
+    for (int i = 0; i < ITERATIONS; i++) {
+        pooled.push_back(measureThroughput<PooledBook>(actions, &pooledPerf));
+        flat.push_back(measureThroughput<FlatBook>(actions, &flatPerf));
+        pooledChurn.push_back(measureThroughput<PooledBook>(churn, &pooledChurnPerf));
+        flatChurn.push_back(measureThroughput<FlatBook>(churn, &flatChurnPerf));
+    }
+
+    auto avg = [](const std::vector<double>& v) { return static_cast<long long>(std::reduce(v.begin(), v.end(), 0.0) / v.size()); };
+
+    std::cout << "\n============================================\n";
+    std::cout << "        PRICE LADDER: POOLED vs FLAT        \n";
+    std::cout << "============================================\n";
+    std::cout << "Ladder memory (both sides, " << DEFAULT_LADDER_WIDTH << "-tick window)\n";
+    std::cout << "  pooled Limit*    : " << std::setw(8) << 2 * PriceLadder(DEFAULT_LADDER_WIDTH).getMemoryBytes() / 1024
+              << " KB\n";
+    std::cout << "  inline headers   : " << std::setw(8)
+              << 2 * FlatPriceLadder(DEFAULT_LADDER_WIDTH).getMemoryBytes() / 1024 << " KB\n";
+    std::cout << "Standard 70/25/5\n";
+    std::cout << "  pooled Limit*    : " << std::setw(11) << avg(pooled) << " ops/sec\n";
+    std::cout << "  inline headers   : " << std::setw(11) << avg(flat) << " ops/sec\n";
+    std::cout << "Touch churn (add + cancel, level created / dropped each time)\n";
+    std::cout << "  pooled Limit*    : " << std::setw(11) << avg(pooledChurn) << " ops/sec\n";
+    std::cout << "  inline headers   : " << std::setw(11) << avg(flatChurn) << " ops/sec\n";
+    if (perf) {
+        const std::uint64_t totalOps = actions.size() * ITERATIONS;
+        std::cout << "--------------------------------------------\n";
+        std::cout << "pooled (standard) : " << describePerf(pooledPerf, totalOps) << "\n";
+        std::cout << "flat   (standard) : " << describePerf(flatPerf, totalOps) << "\n";
+        std::cout << "pooled (churn)    : " << describePerf(pooledChurnPerf, totalOps) << "\n";
+        std::cout << "flat   (churn)    : " << describePerf(flatChurnPerf, totalOps) << "\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Modify-heavy flow: native modifyOrder vs the cancel + re-add clients do without it
+void runModifyBenchmark() {
+    std::cout << "Pre-generating " << ORDER_COUNT << " modify-heavy actions...\n";
+    auto actions = pregenerate(ORDER_COUNT, 42, MODIFY_MIX);
+
+    std::vector<double> native, emulated;
+    PerfSample nativePerf, emulatedPerf;
+    for (int i = 0; i < ITERATIONS; i++) {
+        native.push_back(measureThroughput<BasicBook<NoopListener>>(actions, &nativePerf));
+
+        BasicBook<NoopListener> book(ORDER_COUNT + 1000);
+        if (perf)
+            perf->start();
+        auto startTime = std::chrono::steady_clock::now();
+        for (const auto& order : actions) {
+            if (order.type == OrderType::MODIFY) {
+                book.cancelOrder(order.id);
+                book.addLimitOrder(order.id, order.price, order.qty, order.side);
+            } else {
+                book.process(order);
+            }
+        }
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+        if (perf)
+            emulatedPerf.add(perf->stop());
+        emulated.push_back(actions.size() / duration.count());
+    }
+
+    auto avg = [](const std::vector<double>& v) { return static_cast<long long>(std::reduce(v.begin(), v.end(), 0.0) / v.size()); };
+
+    std::cout << "\n============================================\n";
+    std::cout << "     MODIFY-HEAVY (40/10/5/45 L/C/M/Mod)    \n";
+    std::cout << "============================================\n";
+    std::cout << "modifyOrder        : " << std::setw(11) << avg(native) << " ops/sec\n";
+    std::cout << "cancel + addLimit  : " << std::setw(11) << avg(emulated) << " ops/sec\n";
+    if (perf) {
+        std::cout << "--------------------------------------------\n";
+        std::cout << "modifyOrder        : " << describePerf(nativePerf, actions.size() * ITERATIONS) << "\n";
+        std::cout << "cancel + addLimit  : " << describePerf(emulatedPerf, actions.size() * ITERATIONS) << "\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Cancel-heavy flow on a deep book: `resting` non-crossing orders are placed first, then
+// every step cancels a random live order (anywhere in the book) and places a new one,
+// so the book keeps its size and nearly every cancel misses cache
+std::vector<Command> pregenerateDeepCancels(int resting, int count, unsigned seed = 42) {
+    const Price MID = 100'000;
+    const Price LEVELS_PER_SIDE = 2'000;
+
+    std::vector<Command> actions;
+    actions.reserve(resting + count);
+    std::mt19937 rng(seed);
+    std::vector<OrderId> live;
+    live.reserve(resting);
+    OrderId curId = 1;
+
+    auto place = [&]() {
+        Side side = (rng() % 2 == 0) ? Side::BUY : Side::SELL;
+        Price offset = 1 + rng() % LEVELS_PER_SIDE;
+        Price price = (side == Side::BUY) ? MID - offset : MID + offset;
+        actions.push_back({curId, price, 1 + static_cast<Quantity>(rng() % 100), OrderType::LIMIT, side});
+        live.push_back(curId++);
+    };
+
+    for (int i = 0; i < resting; i++) {
+        place();
+    }
+    while (static_cast<int>(actions.size()) < resting + count) {
+        size_t idx = rng() % live.size();
+        actions.push_back({live[idx], 0, 0, OrderType::CANCEL, Side::BUY});
+        live[idx] = live.back();
+        live.pop_back();
+        place();
+    }
+    actions.resize(resting + count);
+    return actions;
+}
+
+// Batch submission: process() per command vs submitBatch() (look-ahead prefetching),
+// over the whole flow and over ring-sized chunks
+void runBatchBenchmark() {
+    const size_t CHUNK = 64;
+
+    std::cout << "\n============================================\n";
+    std::cout << "     BATCH SUBMISSION (best of " << ITERATIONS << ")          \n";
+    std::cout << "============================================\n";
+
+    const int DEEP_RESTING = 1'000'000;
+
+    struct Workload {
+        const char* name;
+        std::vector<Command> setup; // placed untimed
+        std::vector<Command> actions;
+    };
+    std::vector<Workload> workloads;
+    workloads.push_back({"standard 70/25/5", {}, pregenerate(ORDER_COUNT)});
+    {
+        auto deep = pregenerateDeepCancels(DEEP_RESTING, ORDER_COUNT);
+        workloads.push_back({"cancel-heavy (1M resting, 50/50 C/L)", std::vector<Command>(deep.begin(), deep.begin() + DEEP_RESTING),
+                             std::vector<Command>(deep.begin() + DEEP_RESTING, deep.end())});
+    }
+
+    for (const Workload& workload : workloads) {
+        const auto& actions = workload.actions;
+
+        // Modes take turns within each iteration, so drift on a shared host hits them alike
+        auto timeOnce = [&](auto&& runOnce) {
+            BasicBook<NoopListener> book(DEEP_RESTING + ORDER_COUNT + 1000);
+            for (const auto& order : workload.setup) {
+                book.process(order);
+            }
+
+            auto startTime = std::chrono::steady_clock::now();
+            runOnce(book);
+            std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+            return static_cast<long long>(actions.size() / duration.count());
+        };
+
+        long long single = 0, whole = 0, chunked = 0;
+        for (int i = 0; i < ITERATIONS; i++) {
+            single = std::max(single, timeOnce([&](auto& book) {
+                for (const auto& order : actions) {
+                    book.process(order);
+                }
+            }));
+            whole = std::max(whole, timeOnce([&](auto& book) { book.submitBatch(actions); }));
+            chunked = std::max(chunked, timeOnce([&](auto& book) {
+                std::span<const Command> all(actions);
+                for (size_t j = 0; j < all.size(); j += CHUNK) {
+                    book.submitBatch(all.subspan(j, std::min(CHUNK, all.size() - j)));
+                }
+            }));
+        }
+
+        std::cout << workload.name << "\n";
+        std::cout << "  process()            : " << std::setw(11) << single << " ops/sec\n";
+        std::cout << "  submitBatch (all)    : " << std::setw(11) << whole << " ops/sec (" << std::fixed
+                  << std::setprecision(2) << static_cast<double>(whole) / single << "x)\n";
+        std::cout << "  submitBatch (" << CHUNK << ")     : " << std::setw(11) << chunked << " ops/sec ("
+                  << static_cast<double>(chunked) / single << "x)\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Order layout at scale: BasicBook (48-byte pointer-linked Orders) vs CompactBook
+// (16-byte hot records with 32-bit links + a cold id array), building a 10M-order
+// book and then running the cancel-heavy flow against it
+void runCompactBenchmark() {
+    const int RESTING = 10'000'000;
+    const int REPS = 3;
+    const Price MID = 100'000;
+    const Price BAND = 4'096;
+
+    std::cout << "Pre-generating " << RESTING << " resting orders + " << ORDER_COUNT << " actions...\n";
+    auto deep = pregenerateDeepCancels(RESTING, ORDER_COUNT);
+    std::span<const Command> setup(deep.data(), RESTING);
+    std::span<const Command> actions(deep.data() + RESTING, ORDER_COUNT);
+
+    struct Result {
+        double buildNs = 1e18;
+        double flowNs = 1e18;
+        PerfSample flowPerf;
+    };
+
+    // Layouts take turns within each rep, so drift on a shared host hits them alike
+    auto timeOnce = [&](auto& book, Result& result) {
+        auto startTime = std::chrono::steady_clock::now();
+        for (const auto& order : setup) {
+            book.process(order);
+        }
+        std::chrono::duration<double, std::nano> build = std::chrono::steady_clock::now() - startTime;
+
+        if (perf)
+            perf->start();
+        startTime = std::chrono::steady_clock::now();
+        for (const auto& order : actions) {
+            book.process(order);
+        }
+        std::chrono::duration<double, std::nano> flow = std::chrono::steady_clock::now() - startTime;
+        if (perf)
+            result.flowPerf.add(perf->stop());
+
+        result.buildNs = std::min(result.buildNs, build.count() / RESTING);
+        result.flowNs = std::min(result.flowNs, flow.count() / ORDER_COUNT);
+    };
+
+    Result basic, compact;
+    size_t compactBytes = 0;
+    for (int i = 0; i < REPS; i++) {
+        {
+            auto book = std::make_unique<BasicBook<NoopListener>>(RESTING + 1000);
+            timeOnce(*book, basic);
+        }
+        {
+            auto book = std::make_unique<CompactBook<NoopListener>>(RESTING + 1000, MID - BAND, MID + BAND);
+            timeOnce(*book, compact);
+            compactBytes = book->getMemoryBytes();
+        }
+    }
+
+    std::cout << "\n============================================\n";
+    std::cout << "   ORDER LAYOUT AT 10M RESTING (best of " << REPS << ")   \n";
+    std::cout << "============================================\n";
+    std::cout << "Order record       : BasicBook " << sizeof(Order) << " B | CompactBook "
+              << sizeof(CompactBook<>::Node) << " B hot + " << sizeof(OrderId) << " B cold\n";
+    std::cout << "CompactBook total  : " << std::fixed << std::setprecision(1)
+              << static_cast<double>(compactBytes) / RESTING << " B/order (pool + levels + index)\n";
+    std::cout << "--------------------------------------------\n";
+    std::cout << "Build (10M limits) : BasicBook " << std::setw(6) << basic.buildNs << " ns/order | CompactBook "
+              << std::setw(6) << compact.buildNs << " ns/order\n";
+    std::cout << "Cancel-heavy flow  : BasicBook " << std::setw(6) << basic.flowNs << " ns/op    | CompactBook "
+              << std::setw(6) << compact.flowNs << " ns/op (" << std::setprecision(2) << basic.flowNs / compact.flowNs
+              << "x)\n";
+    if (perf) {
+        std::cout << "--------------------------------------------\n";
+        std::cout << "BasicBook   : " << describePerf(basic.flowPerf, static_cast<std::uint64_t>(ORDER_COUNT) * REPS) << "\n";
+        std::cout << "CompactBook : " << describePerf(compact.flowPerf, static_cast<std::uint64_t>(ORDER_COUNT) * REPS)
+                  << "\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Best-price recovery: a lone far-away bid anchors the book, the touch is placed
+// `gap` ticks above it and cancelled, forcing updateBest<Side::BUY>() to find the far bid.
+void runRecoveryBenchmark() {
+    const int CYCLES = 1'000'000;
+    const Price FLOOR = 10;
+
+    std::cout << "\n============================================\n";
+    std::cout << "        BEST-PRICE RECOVERY (add+cancel)    \n";
+    std::cout << "============================================\n";
+
+    for (Price gap : {1u, 64u, 1'024u, 16'384u, 99'989u}) {
+        BasicBook<NoopListener> book(CYCLES + 10);
+        book.addLimitOrder(0, FLOOR, 1, Side::BUY);
+
+        if (perf)
+            perf->start();
+        auto startTime = std::chrono::steady_clock::now();
+
+        for (int i = 1; i <= CYCLES; i++) {
+            book.addLimitOrder(i, FLOOR + gap, 1, Side::BUY);
+            book.cancelOrder(i);
+        }
+
+        std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - startTime;
+        PerfSample sample;
+        if (perf)
+            sample = perf->stop();
+
+        std::cout << "Gap: " << std::setw(6) << gap << " ticks | " << std::fixed << std::setprecision(1)
+                  << std::setw(7) << duration.count() / CYCLES << " ns/cycle";
+        if (perf)
+            std::cout << " | " << describePerf(sample, CYCLES);
+        std::cout << "\n";
+    }
+    std::cout << "============================================\n";
+}
+
+// Warm restart: a deep non-crossing book is saved, then restored by bulk load
+// versus rebuilt by re-adding every order
+void runSnapshotBenchmark() {
+    const int RESTING_ORDERS = 5'000'000;
+    const Price LEVELS_PER_SIDE = 2'000;
+    const Price MID = 100'000;
+    const std::string path = "orderbook_benchmark.snap";
+
+    std::vector<Command> resting;
+    resting.reserve(RESTING_ORDERS);
+    std::mt19937 rng(42);
+    for (int i = 0; i < RESTING_ORDERS; i++) {
+        Side side = (i % 2 == 0) ? Side::BUY : Side::SELL;
+        Price offset = 1 + rng() % LEVELS_PER_SIDE;
+        Price price = (side == Side::BUY) ? MID - offset : MID + offset;
+        resting.push_back({static_cast<OrderId>(i + 1), price, 1 + static_cast<Quantity>(rng() % 500), OrderType::LIMIT, side});
+    }
+
+    auto elapsedMs = [](auto startTime) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+
+    BasicBook<NoopListener> original(RESTING_ORDERS);
+    auto startTime = std::chrono::steady_clock::now();
+    for (const auto& order : resting) {
+        original.process(order);
+    }
+    double rebuildMs = elapsedMs(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    original.saveSnapshot(path);
+    double saveMs = elapsedMs(startTime);
+
+    BasicBook<NoopListener> restored(RESTING_ORDERS);
+    startTime = std::chrono::steady_clock::now();
+    restored.loadSnapshot(path);
+    double loadMs = elapsedMs(startTime);
+    std::remove(path.c_str());
+
+    std::cout << "\n============================================\n";
+    std::cout << "     SNAPSHOT / RESTORE (" << RESTING_ORDERS << " orders)    \n";
+    std::cout << "============================================\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Rebuild via addLimitOrder : " << std::setw(8) << rebuildMs << " ms\n";
+    std::cout << "saveSnapshot              : " << std::setw(8) << saveMs << " ms\n";
+    std::cout << "loadSnapshot              : " << std::setw(8) << loadMs << " ms\n";
+    std::cout << "============================================\n";
+}
+
+// Write-ahead journal: cost added to the matching thread, then the sustained rate the
+// writer can absorb per backend and group-commit policy
+void runJournalBenchmark() {
+    const std::string path = "orderbook_benchmark.journal";
+    const int SUSTAINED_RECORDS = 4'000'000;
+
+    std::cout << "Pre-generating " << ORDER_COUNT << " actions...\n";
+    auto actions = pregenerate(ORDER_COUNT);
+
+    // Writer on its own core when there is one (otherwise it time-slices with matching)
+    const int writerCore = std::thread::hardware_concurrency() > 1 ? MATCHING_CORE : -1;
+    JournalConfig matchingConfig;
+    matchingConfig.writerCore = writerCore;
+
+    double plainBest = 1e18, journaledBest = 1e18;
+    std::uint64_t stalls = 0;
+    std::string backend;
+    for (int i = 0; i < ITERATIONS; i++) {
+        {
+            BasicBook<NoopListener> book(ORDER_COUNT + 1000);
+            auto startTime = std::chrono::steady_clock::now();
+            for (const auto& order : actions) {
+                book.process(order);
+            }
+            std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - startTime;
+            plainBest = std::min(plainBest, duration.count() / actions.size());
+        }
+        {
+            BasicBook<NoopListener> book(ORDER_COUNT + 1000);
+            Journal journal(path, matchingConfig);
+            auto startTime = std::chrono::steady_clock::now();
+            for (const auto& order : actions) {
+                journal.append(order);
+                book.process(order);
+            }
+            std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - startTime;
+            journaledBest = std::min(journaledBest, duration.count() / actions.size());
+
+            journal.stop();
+            stalls += journal.getAppendStalls();
+            backend = journal.getBackendName();
+        }
+    }
+
+    std::cout << "\n============================================\n";
+    std::cout << "      WRITE-AHEAD JOURNAL (" << backend << ")         \n";
+    std::cout << "============================================\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "process             : " << std::setw(7) << plainBest << " ns/op\n";
+    std::cout << "append + process    : " << std::setw(7) << journaledBest << " ns/op\n";
+    std::cout << "Added on match path : " << std::setw(7) << journaledBest - plainBest << " ns/op (" << stalls
+              << " append stalls)\n";
+    std::cout << "--------------------------------------------\n";
+
+    Command cmd{0, 100, 1, OrderType::LIMIT, Side::BUY};
+    struct Policy {
+        const char* name;
+        size_t syncBytes;
+    };
+    for (JournalBackend kind : {JournalBackend::PWRITE, JournalBackend::IO_URING}) {
+        for (Policy policy : {Policy{"no sync    ", 0}, Policy{"group 4MB  ", 4 << 20}, Policy{"per write  ", 1}}) {
+            JournalConfig cfg;
+            cfg.backend = kind;
+            cfg.syncBytes = policy.syncBytes;
+            cfg.writerCore = writerCore;
+
+            std::unique_ptr<Journal> journal;
+            try {
+                journal = std::make_unique<Journal>(path, cfg);
+            } catch (const std::exception& e) {
+                std::cout << "io_uring unavailable: " << e.what() << "\n";
+                break;
+            }
+
+            auto startTime = std::chrono::steady_clock::now();
+            for (int i = 0; i < SUSTAINED_RECORDS; i++) {
+                cmd.id = i;
+                journal->append(cmd);
+            }
+            journal->stop();
+            std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+            const JournalStats& stats = journal->getStats();
+            std::cout << std::setw(8) << journal->getBackendName() << " " << policy.name << ": " << std::setw(6)
+                      << SUSTAINED_RECORDS / duration.count() / 1e6 << " M rec/s | " << std::setw(6)
+                      << stats.bytes / duration.count() / (1 << 20) << " MB/s | " << stats.writes << " writes, "
+                      << stats.syncs << " syncs\n";
+        }
+    }
+    std::remove(path.c_str());
+    std::cout << "============================================\n";
+}
+
+// Writes the standard pregenerated flow as a command log for the `replay` tool
+void recordWorkload(const std::string& path) {
+    std::cout << "Pre-generating " << ORDER_COUNT << " actions...\n";
+    auto actions = pregenerate(ORDER_COUNT);
+
+    CommandLogWriter writer(path);
+    writer.append(actions);
+    writer.close();
+
+    std::cout << "Recorded " << writer.getRecordCount() << " commands to " << path << "\n";
+}
+
 int main(int argc, char* argv[]) {
     // Pin cores if possible
     pinThreadToCore(0);
     // Benchmark Latency is toggleable
     bool latencyMode = false;
+    // Two-thread mode: gateway thread enqueues, pinned matching thread drains
+    bool pipelineMode = false;
+    // Fills go to a preallocated execution buffer drained every REPORT_BATCH orders
+    bool reportsMode = false;
+    // Compare order-index policies instead of the standard run
+    bool indexMode = false;
+    // Compare price-ladder policies instead of the standard run
+    bool ladderMode = false;
+
+    // Hardware counters apply to whichever scenario runs, so look for --perf first
+    std::unique_ptr<PerfCounters> counters;
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--perf" || arg == "-c") {
+            counters = std::make_unique<PerfCounters>();
+            if (counters->isAvailable()) {
+                perf = counters.get();
+            } else {
+                std::cout << "Hardware counters unavailable, continuing without them: " << counters->getError() << "\n";
+            }
+        }
+    }
+
     for (int i = 0; i < argc; i++) {
         std::string arg = argv[i];
         if (arg == "--latency" || arg == "-l") {
             latencyMode = true;
+        } else if (arg == "--pipeline" || arg == "-p") {
+            pipelineMode = true;
+        } else if (arg == "--reports" || arg == "-b") {
+            reportsMode = true;
+        } else if (arg == "--index" || arg == "-i") {
+            indexMode = true;
+        } else if (arg == "--ladder" || arg == "-f") {
+            ladderMode = true;
+        } else if (arg == "--modify" || arg == "-m") {
+            runModifyBenchmark();
+            return 0;
+        } else if (arg == "--batch" || arg == "-u") {
+            runBatchBenchmark();
+            return 0;
+        } else if (arg == "--compact" || arg == "-o") {
+            runCompactBenchmark();
+            return 0;
+        } else if (arg == "--recovery" || arg == "-r") {
+            runRecoveryBenchmark();
+            return 0;
+        } else if (arg == "--snapshot" || arg == "-k") {
+            runSnapshotBenchmark();
+            return 0;
+        } else if (arg == "--journal" || arg == "-j") {
+            runJournalBenchmark();
+            return 0;
+        } else if ((arg == "--record" || arg == "-w") && i + 1 < argc) {
+            recordWorkload(argv[i + 1]);
+            return 0;
+        } else if (arg == "--scaling" || arg == "-s") {
+            runScalingBenchmark();
+            return 0;
         }
     };
 
     std::cout << "Pre-generating " << ORDER_COUNT << " actions...\n";
     auto actions = pregenerate(ORDER_COUNT);
 
+    if (indexMode) {
+        runIndexBenchmark(actions);
+        return 0;
+    }
+    if (ladderMode) {
+        runLadderBenchmark(actions);
+        return 0;
+    }
+
     BenchmarkRunner runner;
     runner.setMeasureLatency(latencyMode);
+    runner.setPipelined(pipelineMode);
+    runner.setBatchedReports(reportsMode);
 
     std::cout << "Running benchmark...\n";
     if (latencyMode) {
         std::cout << "Latency Tracking Enabled \n";
     }
+    if (pipelineMode) {
+        std::cout << "Pipeline Mode: Gateway -> SPSC Ring -> Matching Thread (Core " << MATCHING_CORE << ")\n";
+    }
 
     for (int i = 0; i < ITERATIONS; i++) {
         runner.run(actions, i);
@@ -0,0 +1,103 @@
+#include "CommandLog.h"
+
+#include <cstring>
+#include <stdexcept>
+
+
+namespace {
+
+constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+CommandLogHeader makeHeader(std::uint64_t recordCount) {
+    return {COMMAND_LOG_MAGIC, COMMAND_LOG_VERSION, sizeof(Command), recordCount, 0};
+}
+
+// Validates the header against the bytes actually present; returns the record count
+size_t checkHeader(const CommandLogHeader& header, size_t fileBytes, const std::string& path) {
+    if (header.magic != COMMAND_LOG_MAGIC || header.version != COMMAND_LOG_VERSION ||
+        header.recordSize != sizeof(Command)) {
+        throw std::runtime_error("not a command log: " + path);
+    }
+    if (header.recordCount > (fileBytes - sizeof(CommandLogHeader)) / sizeof(Command)) {
+        throw std::runtime_error("truncated command log: " + path);
+    }
+    return static_cast<size_t>(header.recordCount);
+}
+
+} // namespace
+
+// --- Writer ---
+
+CommandLogWriter::CommandLogWriter(const std::string& path)
+    : buffer(WRITE_BUFFER_SIZE) {
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot create command log: " + path);
+    }
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+    CommandLogHeader header = makeHeader(0);
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        throw std::runtime_error("cannot write command log: " + path);
+    }
+}
+
+CommandLogWriter::~CommandLogWriter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void CommandLogWriter::append(const Command& cmd) {
+    // Field-wise copy into a zeroed record so padding bytes are deterministic on disk
+    Command record;
+    std::memset(static_cast<void*>(&record), 0, sizeof(record));
+    record.id = cmd.id;
+    record.price = cmd.price;
+    record.qty = cmd.qty;
+    record.type = cmd.type;
+    record.side = cmd.side;
+    record.stopPrice = cmd.stopPrice;
+
+    if (std::fwrite(&record, sizeof(record), 1, file) != 1) {
+        throw std::runtime_error("command log write failed");
+    }
+    recordCount++;
+}
+
+void CommandLogWriter::append(std::span<const Command> cmds) {
+    for (const Command& cmd : cmds) {
+        append(cmd);
+    }
+}
+
+void CommandLogWriter::close() {
+    if (!file)
+        return;
+
+    CommandLogHeader header = makeHeader(recordCount);
+    bool ok = std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+
+    if (!ok) {
+        throw std::runtime_error("command log close failed");
+    }
+}
+
+// --- Reader ---
+
+CommandLogReader::CommandLogReader(const std::string& path)
+    : file(path) {
+    if (file.size() < sizeof(CommandLogHeader)) {
+        throw std::runtime_error("not a command log: " + path);
+    }
+
+    CommandLogHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    count = checkHeader(header, file.size(), path);
+
+    // Page-aligned mapping + 32-byte header keeps the records naturally aligned
+    first = reinterpret_cast<const Command*>(file.data() + sizeof(CommandLogHeader));
+}
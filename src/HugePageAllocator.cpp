@@ -0,0 +1,79 @@
+#include "HugePageAllocator.h"
+
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+size_t roundUp(size_t n, size_t multiple) { return ((n + multiple - 1) / multiple) * multiple; }
+
+} // namespace
+
+MemoryRegion allocateRegion(size_t bytes, bool populate) {
+    MemoryRegion region;
+
+#ifdef __linux__
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    // 1. Explicit huge pages (needs vm.nr_hugepages reserved by the admin)
+    if (bytes >= HUGE_PAGE_SIZE) {
+        size_t hugeBytes = roundUp(bytes, HUGE_PAGE_SIZE);
+        void* p = mmap(nullptr, hugeBytes, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB | (populate ? MAP_POPULATE : 0), -1, 0);
+        if (p != MAP_FAILED) {
+            return {p, hugeBytes, true};
+        }
+    }
+
+    // 2. Regular pages, asking for Transparent Huge Pages where the region is large enough.
+    // No MAP_POPULATE here: it would fault every page in as 4KB before the advice exists.
+    region.bytes = roundUp(bytes, (bytes >= HUGE_PAGE_SIZE) ? HUGE_PAGE_SIZE : BASE_PAGE_SIZE);
+    void* p = mmap(nullptr, region.bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    if (region.bytes >= HUGE_PAGE_SIZE) {
+        madvise(p, region.bytes, MADV_HUGEPAGE);
+    }
+    region.base = p;
+
+    if (populate) {
+        // Fault in after the advice so the kernel can back it with huge pages
+        // (MADV_POPULATE_WRITE needs Linux 5.14+; older kernels take the touch loop)
+#ifdef MADV_POPULATE_WRITE
+        if (madvise(p, region.bytes, MADV_POPULATE_WRITE) != 0)
+            prefaultRegion(region);
+#else
+        prefaultRegion(region);
+#endif
+    }
+#else
+    region.bytes = roundUp(bytes, BASE_PAGE_SIZE);
+    region.base = ::operator new(region.bytes, std::align_val_t(BASE_PAGE_SIZE));
+    if (populate) {
+        prefaultRegion(region);
+    }
+#endif
+
+    return region;
+}
+
+void releaseRegion(const MemoryRegion& region) {
+    if (region.base == nullptr)
+        return;
+
+#ifdef __linux__
+    munmap(region.base, region.bytes);
+#else
+    ::operator delete(region.base, std::align_val_t(BASE_PAGE_SIZE));
+#endif
+}
+
+void prefaultRegion(const MemoryRegion& region) {
+    volatile char* p = static_cast<volatile char*>(region.base);
+    for (size_t offset = 0; offset < region.bytes; offset += BASE_PAGE_SIZE) {
+        p[offset] = p[offset];
+    }
+}
@@ -0,0 +1,200 @@
+#include "ItchFeedHandler.h"
+#include "MappedFile.h"
+#include "Threading.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ITCH 5.0 feed-handler benchmark over a local file (no network involved).
+//   itch_benchmark --generate <file.itch> [messages]   writes a synthetic sample
+//   itch_benchmark <file.itch> [--iterations N] [--orders-per-book N]
+//                                                       replays a (sample or captured) file
+// --orders-per-book sizes each book's initial pools and growth chunks: keep it small for
+// full-market files (thousands of locates), raise it for a few deep books.
+
+const int DEFAULT_ITERATIONS = 5;
+const size_t DEFAULT_ORDERS_PER_BOOK = 4096;
+const size_t DEFAULT_SAMPLE_MESSAGES = 2'000'000;
+const std::uint16_t SAMPLE_SYMBOLS = 64;
+// $100.0000 in ITCH 4-decimal ticks, one cent = 100 ticks
+const Price SAMPLE_MID = 1'000'000;
+const Price CENT = 100;
+const size_t FLUSH_BYTES = 1 << 20;
+
+struct SampleOrder {
+    std::uint64_t ref;
+    Side side;
+    Quantity shares;
+};
+
+// Per-symbol non-crossing flow: 50% add, 15% execute, 10% partial cancel, 15% delete, 10% replace
+void generateSample(const std::string& path, size_t messageCount) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot create " + path);
+    }
+
+    std::mt19937 rng(42);
+    std::discrete_distribution<int> opDist({50, 15, 10, 15, 10});
+    std::uniform_int_distribution<Price> offsetDist(1, 200);
+    std::lognormal_distribution<double> sharesDist(4.5, 0.8);
+
+    std::vector<std::vector<SampleOrder>> live(SAMPLE_SYMBOLS + 1);
+    std::uint64_t nextRef = 1;
+    std::uint64_t timestamp = 34'200'000'000'000ULL; // 09:30:00
+
+    itch::Encoder encoder;
+    encoder.systemEvent('O', timestamp);
+
+    auto randomPrice = [&](Side side) {
+        Price offset = offsetDist(rng) * CENT;
+        return (side == Side::BUY) ? SAMPLE_MID - offset : SAMPLE_MID + offset;
+    };
+
+    for (size_t i = 0; i < messageCount; i++) {
+        std::uint16_t locate = static_cast<std::uint16_t>(1 + rng() % SAMPLE_SYMBOLS);
+        auto& orders = live[locate];
+        int op = orders.empty() ? 0 : opDist(rng);
+        timestamp += 1 + rng() % 1000;
+
+        if (op == 0) {
+            Side side = (rng() & 1) ? Side::BUY : Side::SELL;
+            Quantity shares = static_cast<Quantity>(std::max(1.0, sharesDist(rng)));
+            encoder.addOrder(locate, nextRef, side, shares, randomPrice(side), timestamp, (rng() % 10) == 0);
+            orders.push_back({nextRef++, side, shares});
+            continue;
+        }
+
+        size_t pick = rng() % orders.size();
+        SampleOrder& order = orders[pick];
+        auto removePick = [&]() {
+            orders[pick] = orders.back();
+            orders.pop_back();
+        };
+
+        if (op == 1 || op == 2) {
+            Quantity shares = 1 + static_cast<Quantity>(rng() % order.shares);
+            if (op == 1) {
+                encoder.orderExecuted(locate, order.ref, shares, timestamp);
+            } else {
+                encoder.orderCancel(locate, order.ref, shares, timestamp);
+            }
+            order.shares -= shares;
+            if (order.shares == 0)
+                removePick();
+        } else if (op == 3) {
+            encoder.orderDelete(locate, order.ref, timestamp);
+            removePick();
+        } else {
+            Quantity shares = static_cast<Quantity>(std::max(1.0, sharesDist(rng)));
+            encoder.orderReplace(locate, order.ref, nextRef, shares, randomPrice(order.side), timestamp);
+            order.ref = nextRef++;
+            order.shares = shares;
+        }
+
+        if (encoder.bytes().size() >= FLUSH_BYTES) {
+            std::fwrite(encoder.bytes().data(), 1, encoder.bytes().size(), file);
+            encoder.clear();
+        }
+    }
+
+    std::fwrite(encoder.bytes().data(), 1, encoder.bytes().size(), file);
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("cannot write " + path);
+    }
+
+    std::cout << "Wrote " << messageCount + 1 << " messages (" << SAMPLE_SYMBOLS << " symbols) to " << path << "\n";
+}
+
+void runFeed(const std::string& path, int iterations, size_t ordersPerBook) {
+    MappedFile file(path);
+    std::span<const std::uint8_t> bytes = file.bytes();
+
+    std::cout << "\n============================================\n";
+    std::cout << "            ITCH 5.0 FEED HANDLER           \n";
+    std::cout << "============================================\n";
+    std::cout << "File              : " << path << " (" << std::fixed << std::setprecision(1)
+              << bytes.size() / (1024.0 * 1024.0) << " MB)\n";
+
+    std::vector<double> runs;
+    itch::FeedStats stats;
+    size_t bookCount = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        ItchFeedHandler<> handler(ordersPerBook);
+
+        auto startTime = std::chrono::steady_clock::now();
+        size_t consumed = handler.processStream(bytes);
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+        stats = handler.getStats();
+        bookCount = handler.getBookCount();
+        runs.push_back(stats.messages / duration.count());
+
+        std::cout << "Iteration " << std::setw(2) << i << " | Tput: " << std::setw(11) << static_cast<long long>(runs.back())
+                  << " msgs/s | " << std::setprecision(0) << (consumed / (1024.0 * 1024.0)) / duration.count()
+                  << " MB/s\n";
+    }
+
+    double best = *std::max_element(runs.begin(), runs.end());
+    std::cout << "--------------------------------------------\n";
+    std::cout << "Messages          : " << stats.messages << " (" << bookCount << " books)\n";
+    std::cout << "  Add / Execute   : " << stats.adds << " / " << stats.executions << "\n";
+    std::cout << "  Cancel / Delete : " << stats.cancels << " / " << stats.deletes << "\n";
+    std::cout << "  Replace         : " << stats.replaces << "\n";
+    std::cout << "  Skipped / Bad   : " << stats.skipped << " / " << stats.malformed << "\n";
+    std::cout << "Best Throughput   : " << static_cast<long long>(best) << " msgs/sec (" << std::setprecision(1)
+              << 1e9 / best << " ns/msg)\n";
+    std::cout << "============================================\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    std::string generatePath;
+    size_t sampleMessages = DEFAULT_SAMPLE_MESSAGES;
+    int iterations = DEFAULT_ITERATIONS;
+    size_t ordersPerBook = DEFAULT_ORDERS_PER_BOOK;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--generate" || arg == "-g") && i + 1 < argc) {
+            generatePath = argv[++i];
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                sampleMessages = std::stoull(argv[++i]);
+            }
+        } else if ((arg == "--iterations" || arg == "-n") && i + 1 < argc) {
+            iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--orders-per-book" && i + 1 < argc) {
+            ordersPerBook = std::max<size_t>(1, std::stoull(argv[++i]));
+        } else {
+            path = arg;
+        }
+    }
+
+    try {
+        if (!generatePath.empty()) {
+            generateSample(generatePath, sampleMessages);
+            return 0;
+        }
+        if (path.empty()) {
+            std::cerr << "usage: itch_benchmark <file.itch> [--iterations N] [--orders-per-book N]\n"
+                      << "       itch_benchmark --generate <file.itch> [messages]\n";
+            return 1;
+        }
+
+        pinThreadToCore(0);
+        runFeed(path, iterations, ordersPerBook);
+    } catch (const std::exception& e) {
+        std::cerr << "itch_benchmark: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,440 @@
+#include "Journal.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ORDERBOOK_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+void pwriteAll(int fd, const void* data, size_t bytes, std::uint64_t offset) {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t n = ::pwrite(fd, p, bytes, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "journal pwrite");
+        }
+        p += n;
+        bytes -= static_cast<size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+}
+
+void syncData(int fd) {
+#ifdef __APPLE__
+    int rc = ::fsync(fd);
+#else
+    int rc = ::fdatasync(fd);
+#endif
+    if (rc != 0) {
+        throw std::system_error(errno, std::generic_category(), "journal fdatasync");
+    }
+}
+
+} // namespace
+
+// Writer-thread I/O strategy. Owns the file descriptor.
+class JournalIo {
+protected:
+    int fd;
+
+public:
+    explicit JournalIo(int f)
+        : fd(f) {}
+    virtual ~JournalIo() { ::close(fd); }
+
+    // Starts writing `bytes` at `offset`; the buffer must stay untouched until wait()
+    virtual void write(const void* data, size_t bytes, std::uint64_t offset) = 0;
+    // Blocks until every started write has completed
+    virtual void wait() = 0;
+    // Blocks until every started write is on stable storage
+    virtual void sync() = 0;
+    virtual const char* name() const = 0;
+};
+
+namespace {
+
+class PwriteIo final : public JournalIo {
+public:
+    using JournalIo::JournalIo;
+
+    void write(const void* data, size_t bytes, std::uint64_t offset) override { pwriteAll(fd, data, bytes, offset); }
+    void wait() override {}
+    void sync() override { syncData(fd); }
+    const char* name() const override { return "pwrite"; }
+};
+
+#ifdef ORDERBOOK_HAS_IO_URING
+// Minimal io_uring driver over the raw syscalls (no liburing dependency).
+// One operation is in flight at a time: the writer overlaps filling the next buffer
+// with the kernel writing the previous one, which is all the journal needs.
+class UringIo final : public JournalIo {
+private:
+    static constexpr unsigned RING_ENTRIES = 8;
+
+    int ringFd = -1;
+    void* sqRing = MAP_FAILED;
+    size_t sqRingBytes = 0;
+    void* cqRing = MAP_FAILED;
+    size_t cqRingBytes = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesBytes = 0;
+
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    bool inFlight = false;
+    // The write in flight (re-issued with pwrite if the kernel completes it short)
+    const char* pendingData = nullptr;
+    size_t pendingBytes = 0;
+    std::uint64_t pendingOffset = 0;
+    // Kernel has io_uring but not IORING_OP_WRITE (< 5.6): pwrite from then on
+    bool writeUnsupported = false;
+
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    void submit(const io_uring_sqe& sqe) {
+        unsigned tail = *sqTail;
+        unsigned idx = tail & *sqMask;
+        sqes[idx] = sqe;
+        sqArray[idx] = idx;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+        while (enter(1, 0, 0) < 0) {
+            if (errno != EINTR)
+                throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+        }
+        inFlight = true;
+    }
+
+    // Waits for the single in-flight operation and returns its result
+    int reap() {
+        while (true) {
+            unsigned head = *cqHead;
+            if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                int res = cqes[head & *cqMask].res;
+                __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                inFlight = false;
+                return res;
+            }
+            if (enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+        }
+    }
+
+public:
+    explicit UringIo(int f)
+        : JournalIo(f) {}
+
+    ~UringIo() override {
+        if (inFlight) {
+            try {
+                reap();
+            } catch (...) {
+            }
+        }
+        if (sqes != MAP_FAILED)
+            ::munmap(sqes, sqesBytes);
+        if (cqRing != MAP_FAILED && cqRing != sqRing)
+            ::munmap(cqRing, cqRingBytes);
+        if (sqRing != MAP_FAILED)
+            ::munmap(sqRing, sqRingBytes);
+        if (ringFd >= 0)
+            ::close(ringFd);
+    }
+
+    // False if the kernel refuses io_uring (too old, seccomp, io_uring_disabled, ...)
+    bool init() {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+        if (ringFd < 0)
+            return false;
+
+        sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            sqRingBytes = cqRingBytes = std::max(sqRingBytes, cqRingBytes);
+        }
+
+        sqRing = ::mmap(nullptr, sqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED)
+            return false;
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            cqRing = sqRing;
+        } else {
+            cqRing = ::mmap(nullptr, cqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED)
+                return false;
+        }
+
+        sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(
+            ::mmap(nullptr, sqesBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED)
+            return false;
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void write(const void* data, size_t bytes, std::uint64_t offset) override {
+        wait();
+
+        if (writeUnsupported) {
+            pwriteAll(fd, data, bytes, offset);
+            return;
+        }
+
+        io_uring_sqe sqe;
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_WRITE;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(data);
+        sqe.len = static_cast<std::uint32_t>(bytes);
+        sqe.off = offset;
+
+        pendingData = static_cast<const char*>(data);
+        pendingBytes = bytes;
+        pendingOffset = offset;
+        submit(sqe);
+    }
+
+    void wait() override {
+        if (!inFlight)
+            return;
+
+        int res = reap();
+        if (res == -EINVAL || res == -EOPNOTSUPP) {
+            writeUnsupported = true;
+            res = 0;
+        } else if (res < 0) {
+            throw std::system_error(-res, std::generic_category(), "io_uring write");
+        }
+
+        // Short (or refused) write: finish it synchronously
+        if (static_cast<size_t>(res) < pendingBytes) {
+            pwriteAll(fd, pendingData + res, pendingBytes - res, pendingOffset + res);
+        }
+    }
+
+    void sync() override {
+        wait();
+
+        io_uring_sqe sqe;
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_FSYNC;
+        sqe.fd = fd;
+        sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+        submit(sqe);
+
+        int res = reap();
+        if (res < 0) {
+            throw std::system_error(-res, std::generic_category(), "io_uring fsync");
+        }
+    }
+
+    const char* name() const override { return "io_uring"; }
+};
+#endif
+
+} // namespace
+
+// --- Journal ---
+
+Journal::Journal(const std::string& path, JournalConfig cfg)
+    : config(cfg)
+    , queue(cfg.queueCapacity) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("cannot create journal: " + path);
+    }
+
+    try {
+        JournalHeader header{JOURNAL_MAGIC, JOURNAL_VERSION, sizeof(JournalRecord)};
+        pwriteAll(fd, &header, sizeof(header), 0);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+
+#ifdef ORDERBOOK_HAS_IO_URING
+    if (config.backend != JournalBackend::PWRITE) {
+        auto uring = std::make_unique<UringIo>(::dup(fd));
+        if (uring->init()) {
+            io = std::move(uring);
+        }
+    }
+#endif
+    if (!io && config.backend == JournalBackend::IO_URING) {
+        ::close(fd);
+        throw std::runtime_error("io_uring is not available for journal: " + path);
+    }
+
+    if (io) {
+        ::close(fd);
+    } else {
+        io = std::make_unique<PwriteIo>(fd);
+    }
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&Journal::run, this);
+}
+
+Journal::~Journal() { stop(); }
+
+void Journal::stop() {
+    running.store(false, std::memory_order_release);
+
+    if (writer.joinable())
+        writer.join();
+}
+
+const char* Journal::getBackendName() const { return io->name(); }
+
+void Journal::run() {
+    if (config.writerCore >= 0) {
+        pinThreadToCore(config.writerCore);
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    // Double buffering: one batch is being written while the next one fills
+    const size_t batchRecords = std::max<size_t>(config.batchBytes / sizeof(JournalRecord), 1);
+    std::vector<JournalRecord> buffers[2] = {std::vector<JournalRecord>(batchRecords), std::vector<JournalRecord>(batchRecords)};
+    int current = 0;
+    size_t filled = 0;
+
+    std::uint64_t offset = sizeof(JournalHeader);
+    std::uint64_t writtenSequence = 0;
+    std::uint64_t unsyncedBytes = 0;
+    Clock::time_point oldestUnsynced;
+
+    auto flushBatch = [&]() {
+        if (filled == 0)
+            return;
+
+        size_t bytes = filled * sizeof(JournalRecord);
+        io->write(buffers[current].data(), bytes, offset);
+
+        offset += bytes;
+        writtenSequence = buffers[current][filled - 1].sequence;
+        if (unsyncedBytes == 0)
+            oldestUnsynced = Clock::now();
+        unsyncedBytes += bytes;
+
+        stats.records += filled;
+        stats.bytes += bytes;
+        stats.writes++;
+
+        current ^= 1;
+        filled = 0;
+    };
+
+    auto groupCommit = [&]() {
+        if (unsyncedBytes == 0)
+            return;
+        io->sync();
+        unsyncedBytes = 0;
+        stats.syncs++;
+        durableSequence.store(writtenSequence, std::memory_order_release);
+    };
+
+    auto collect = [&](const JournalRecord& record) { buffers[current][filled++] = record; };
+    auto discard = [](const JournalRecord&) {};
+
+    try {
+        while (true) {
+            size_t n = queue.consume(collect, batchRecords - filled);
+
+            if (filled == batchRecords) {
+                flushBatch();
+            } else if (n == 0) {
+                // Ring is empty: write the partial batch rather than wait for more
+                flushBatch();
+
+                if (!running.load(std::memory_order_acquire)) {
+                    if (queue.empty())
+                        break;
+                    continue;
+                }
+
+                bool intervalDue = config.syncBytes > 0 && unsyncedBytes > 0 &&
+                                   Clock::now() - oldestUnsynced >= config.syncInterval;
+                if (intervalDue) {
+                    groupCommit();
+                } else {
+                    // Nothing to do: give the core back (the journal is not latency-critical)
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+
+            if (config.syncBytes > 0 && unsyncedBytes >= config.syncBytes) {
+                groupCommit();
+            }
+        }
+
+        // Final commit, whatever the sync policy
+        flushBatch();
+        groupCommit();
+    } catch (const std::exception&) {
+        failed.store(true, std::memory_order_release);
+
+        // Keep the producer from stalling: drop everything until stopped
+        while (running.load(std::memory_order_acquire) || !queue.empty()) {
+            if (queue.consume(discard) == 0)
+                std::this_thread::yield();
+        }
+    }
+}
+
+// --- Reader ---
+
+JournalReader::JournalReader(const std::string& path)
+    : file(path) {
+    JournalHeader header;
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error("not a journal: " + path);
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION || header.recordSize != sizeof(JournalRecord)) {
+        throw std::runtime_error("not a journal: " + path);
+    }
+
+    // A crash can leave a torn record at the end: only whole records count
+    count = (file.size() - sizeof(header)) / sizeof(JournalRecord);
+    first = reinterpret_cast<const JournalRecord*>(file.data() + sizeof(header));
+}
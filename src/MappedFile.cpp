@@ -0,0 +1,70 @@
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef __linux__
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("cannot stat " + path);
+    }
+
+    length = static_cast<size_t>(st.st_size);
+    if (length == 0) {
+        // mmap rejects empty mappings; an empty file is simply an empty view
+        ::close(fd);
+        return;
+    }
+
+    mappedBytes = length;
+    mapping = ::mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("cannot map " + path);
+    }
+    ::madvise(mapping, mappedBytes, MADV_SEQUENTIAL);
+
+    first = static_cast<const std::uint8_t*>(mapping);
+#else
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+
+    std::fseek(file, 0, SEEK_END);
+    fallback.resize(static_cast<size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+
+    size_t got = std::fread(fallback.data(), 1, fallback.size(), file);
+    std::fclose(file);
+    if (got != fallback.size()) {
+        throw std::runtime_error("cannot read " + path);
+    }
+
+    first = fallback.data();
+    length = fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef __linux__
+    if (mapping) {
+        ::munmap(mapping, mappedBytes);
+    }
+#endif
+}
@@ -0,0 +1,415 @@
+#include "Bitmask.h"
+#include "Book.h"
+#include "WordScan.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Per-operation microbenchmarks (Google Benchmark). Each scenario isolates one book
+// operation on a prepared book; the book is restored with timing paused, so only the
+// operation itself is measured.
+//   micro_benchmark --benchmark_filter=Cancel --benchmark_out=cancel.json --benchmark_out_format=json
+// (--benchmark_out_format=csv for CSV; tools/compare.py from Google Benchmark diffs two JSON runs)
+
+namespace {
+
+using BenchBook = BasicBook<NoopListener>;
+
+const Price MID = 100'000;
+const size_t MAX_ORDERS = 1 << 18;
+// Operations per timed batch (restoring the book costs a PauseTiming/ResumeTiming pair)
+const std::int64_t BATCH = 256;
+const Quantity LOT = 10;
+
+// Book depths (levels per side) every depth-sensitive scenario runs at. All of them fit
+// in the default ladder window, so no scenario measures the overflow map.
+void depthArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("depth");
+    for (int depth : {1, 16, 128, 512}) {
+        b->Arg(depth);
+    }
+}
+
+Price levelPrice(Side side, int level, Price gap) {
+    Price offset = static_cast<Price>(level + 1) * gap;
+    return (side == Side::BUY) ? MID - offset : MID + offset;
+}
+
+// `depth` levels per side, `gap` ticks apart, with `perLevel` orders of `qty` each.
+// Records the bid queues (front = time priority) when `bidQueues` is given.
+void buildBook(BenchBook& book, OrderId& nextId, int depth, int perLevel, Quantity qty, Price gap,
+               std::vector<std::deque<OrderId>>* bidQueues = nullptr) {
+    if (bidQueues)
+        bidQueues->assign(depth, {});
+
+    for (int level = 0; level < depth; level++) {
+        for (int i = 0; i < perLevel; i++) {
+            OrderId bid = nextId++;
+            book.addLimitOrder(bid, levelPrice(Side::BUY, level, gap), qty, Side::BUY);
+            book.addLimitOrder(nextId++, levelPrice(Side::SELL, level, gap), qty, Side::SELL);
+            if (bidQueues)
+                (*bidQueues)[level].push_back(bid);
+        }
+    }
+}
+
+} // namespace
+
+// Limit order that opens a new price level. Levels sit on even ticks, inserts go to odd
+// ticks: into the gaps of the book first, then beyond its deepest level.
+static void BM_InsertNewLevel(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+    buildBook(book, nextId, depth, 4, LOT, 2);
+
+    while (state.KeepRunningBatch(BATCH)) {
+        OrderId first = nextId;
+        for (std::int64_t i = 0; i < BATCH; i++) {
+            book.addLimitOrder(nextId++, MID - 1 - 2 * static_cast<Price>(i), LOT, Side::BUY);
+        }
+
+        state.PauseTiming();
+        for (OrderId id = first; id < nextId; id++) {
+            book.cancelOrder(id);
+        }
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_InsertNewLevel)->Apply(depthArgs);
+
+// Limit order joining the queue of an existing level (round-robin over the levels)
+static void BM_InsertExistingLevel(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+    buildBook(book, nextId, depth, 4, LOT, 2);
+
+    while (state.KeepRunningBatch(BATCH)) {
+        OrderId first = nextId;
+        for (std::int64_t i = 0; i < BATCH; i++) {
+            book.addLimitOrder(nextId++, levelPrice(Side::BUY, static_cast<int>(i % depth), 2), LOT, Side::BUY);
+        }
+
+        state.PauseTiming();
+        for (OrderId id = first; id < nextId; id++) {
+            book.cancelOrder(id);
+        }
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_InsertExistingLevel)->Apply(depthArgs);
+
+enum class QueuePosition { HEAD, MIDDLE, TAIL };
+
+// Cancel of a resting order at the head, middle or tail of its level's queue. The level
+// never empties, so this is the unlink cost alone (no best-price recovery).
+template <QueuePosition P>
+static void BM_Cancel(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const int PER_LEVEL = 64;
+    // At most half of a queue is cancelled per batch, so "middle" stays in the middle
+    const std::int64_t batch = std::min<std::int64_t>(BATCH, depth * PER_LEVEL / 2);
+
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+    std::vector<std::deque<OrderId>> queues;
+    buildBook(book, nextId, depth, PER_LEVEL, LOT, 1, &queues);
+
+    std::vector<OrderId> targets(batch);
+    auto pickTargets = [&]() {
+        for (std::int64_t i = 0; i < batch; i++) {
+            auto& queue = queues[i % depth];
+            size_t pos = (P == QueuePosition::HEAD) ? 0 : (P == QueuePosition::TAIL) ? queue.size() - 1 : queue.size() / 2;
+            targets[i] = queue[pos];
+            queue.erase(queue.begin() + pos);
+        }
+    };
+    pickTargets();
+
+    while (state.KeepRunningBatch(batch)) {
+        for (OrderId id : targets) {
+            book.cancelOrder(id);
+        }
+
+        state.PauseTiming();
+        // Re-adding at the back keeps every queue PER_LEVEL long
+        for (std::int64_t i = 0; i < batch; i++) {
+            int level = static_cast<int>(i % depth);
+            book.addLimitOrder(targets[i], levelPrice(Side::BUY, level, 1), LOT, Side::BUY);
+            queues[level].push_back(targets[i]);
+        }
+        pickTargets();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK_TEMPLATE(BM_Cancel, QueuePosition::HEAD)->Apply(depthArgs);
+BENCHMARK_TEMPLATE(BM_Cancel, QueuePosition::MIDDLE)->Apply(depthArgs);
+BENCHMARK_TEMPLATE(BM_Cancel, QueuePosition::TAIL)->Apply(depthArgs);
+
+// One aggressive limit order that clears the whole ask side (depth levels x 4 orders)
+static void BM_DeepSweep(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const int PER_LEVEL = 4;
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+    buildBook(book, nextId, depth, PER_LEVEL, LOT, 1);
+
+    const Quantity sweepQty = static_cast<Quantity>(depth * PER_LEVEL) * LOT;
+    const Price limit = levelPrice(Side::SELL, depth - 1, 1);
+
+    for (auto _ : state) {
+        book.addLimitOrder(nextId++, limit, sweepQty, Side::BUY);
+
+        state.PauseTiming();
+        for (int level = 0; level < depth; level++) {
+            for (int i = 0; i < PER_LEVEL; i++) {
+                book.addLimitOrder(nextId++, levelPrice(Side::SELL, level, 1), LOT, Side::SELL);
+            }
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * depth * PER_LEVEL);
+}
+BENCHMARK(BM_DeepSweep)->Apply(depthArgs);
+
+// Unit market orders against a thin book (one unit order per adjacent level): every
+// order empties the touch and promotes the next level. depth:1 refills after every
+// order, so it also carries the PauseTiming overhead.
+static void BM_MarketThinBook(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+    buildBook(book, nextId, depth, 1, 1, 1);
+
+    while (state.KeepRunningBatch(depth)) {
+        for (int i = 0; i < depth; i++) {
+            book.addMarketOrder(nextId++, 1, Side::BUY);
+        }
+
+        state.PauseTiming();
+        for (int level = 0; level < depth; level++) {
+            book.addLimitOrder(nextId++, levelPrice(Side::SELL, level, 1), 1, Side::SELL);
+        }
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_MarketThinBook)->Apply(depthArgs);
+
+// Best-price recovery after the touch is depleted: single-order bid levels `gap` ticks
+// apart, the best one is cancelled and the book must find the next one
+static void BM_RecoveryAfterDepletion(benchmark::State& state) {
+    const Price gap = static_cast<Price>(state.range(0));
+    const int LEVELS = 8;
+    BenchBook book(MAX_ORDERS);
+    // Floor level below the cancelled ones, so the side never empties
+    book.addLimitOrder(0, levelPrice(Side::BUY, LEVELS, gap), LOT, Side::BUY);
+
+    auto restore = [&]() {
+        for (int level = 0; level < LEVELS; level++) {
+            book.addLimitOrder(level + 1, levelPrice(Side::BUY, level, gap), LOT, Side::BUY);
+        }
+    };
+    restore();
+
+    while (state.KeepRunningBatch(LEVELS)) {
+        for (int level = 0; level < LEVELS; level++) {
+            book.cancelOrder(level + 1);
+        }
+
+        state.PauseTiming();
+        restore();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_RecoveryAfterDepletion)->ArgName("gap")->Arg(1)->Arg(16)->Arg(128);
+
+// IOC that finds nothing to take. NATIVE drops it after the cross check; otherwise it is
+// emulated as a limit order that rests and is cancelled again (pool, index and level churn)
+template <bool NATIVE>
+static void BM_IocNoFill(benchmark::State& state) {
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+    buildBook(book, nextId, 16, 4, LOT, 1);
+
+    const Price price = levelPrice(Side::BUY, 0, 1) + 1;
+    for (auto _ : state) {
+        OrderId id = nextId++;
+        if constexpr (NATIVE) {
+            book.addIocOrder(id, price, LOT, Side::BUY);
+        } else {
+            book.addLimitOrder(id, price, LOT, Side::BUY);
+            book.cancelOrder(id);
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_IocNoFill, false);
+BENCHMARK_TEMPLATE(BM_IocNoFill, true);
+
+// FOK for one lot more than the whole ask side: killed after the read-only liquidity
+// check, which walks every level (or asks the volume index when INDEXED)
+template <bool INDEXED>
+static void BM_FokKilled(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    BenchBook book(MAX_ORDERS);
+    book.enableVolumeIndex(INDEXED);
+    OrderId nextId = 1;
+    buildBook(book, nextId, depth, 4, LOT, 1);
+
+    const Quantity qty = static_cast<Quantity>(depth * 4 + 1) * LOT;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.addFokOrder(nextId++, MAX_PRICE - 1, qty, Side::BUY));
+    }
+}
+BENCHMARK_TEMPLATE(BM_FokKilled, false)->Apply(depthArgs);
+BENCHMARK_TEMPLATE(BM_FokKilled, true)->Apply(depthArgs);
+
+// Stop cascade: `stops` buy stops, 16 per trigger tick above the touch, each tick holding
+// 16 lots of asks. One unit market buy fires the first tick, and every tick's stops
+// consume it and trade into the next, so all stops are released (per-stop cost).
+static void BM_StopCascade(benchmark::State& state) {
+    const int stops = static_cast<int>(state.range(0));
+    const int PER_TICK = 16;
+    const int ticks = stops / PER_TICK;
+    BenchBook book(MAX_ORDERS);
+    OrderId nextId = 1;
+
+    auto restore = [&]() {
+        for (int t = 0; t < ticks; t++) {
+            Price price = MID + 1 + t;
+            book.addLimitOrder(nextId++, price, PER_TICK, Side::SELL);
+            for (int i = 0; i < PER_TICK; i++) {
+                book.addStopOrder(nextId++, price, 1, Side::BUY);
+            }
+        }
+    };
+    restore();
+
+    while (state.KeepRunningBatch(ticks * PER_TICK)) {
+        book.addMarketOrder(nextId++, 1, Side::BUY);
+
+        state.PauseTiming();
+        book.clear();
+        restore();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_StopCascade)->ArgName("stops")->Arg(1'024)->Arg(16'384)->Arg(65'536);
+
+// Liquidity query: the price a market buy for half the ask side's volume would reach.
+// INDEXED answers from the Fenwick volume index, otherwise the levels are walked.
+template <bool INDEXED>
+static void BM_SweepQuery(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    BenchBook book(MAX_ORDERS);
+    book.enableVolumeIndex(INDEXED);
+    OrderId nextId = 1;
+    buildBook(book, nextId, depth, 4, LOT, 1);
+
+    const std::uint64_t qty = static_cast<std::uint64_t>(depth) * 4 * LOT / 2;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.getSweepPrice(Side::SELL, qty));
+    }
+}
+BENCHMARK_TEMPLATE(BM_SweepQuery, false)->Apply(depthArgs);
+BENCHMARK_TEMPLATE(BM_SweepQuery, true)->Apply(depthArgs);
+
+// Upkeep of the volume index: an order opens a level behind the touch and is cancelled
+// again (two level changes per iteration)
+template <bool INDEXED>
+static void BM_LevelChurn(benchmark::State& state) {
+    BenchBook book(MAX_ORDERS);
+    book.enableVolumeIndex(INDEXED);
+    OrderId nextId = 1;
+    buildBook(book, nextId, 128, 1, LOT, 2);
+
+    int level = 0;
+    for (auto _ : state) {
+        OrderId id = nextId++;
+        book.addLimitOrder(id, levelPrice(Side::BUY, level, 2) + 1, LOT, Side::BUY);
+        book.cancelOrder(id);
+        level = (level + 1) % 128;
+    }
+}
+BENCHMARK_TEMPLATE(BM_LevelChurn, false);
+BENCHMARK_TEMPLATE(BM_LevelChurn, true);
+
+// Bitmask scan from one populated level to the next, `gap` ticks apart, over a
+// 262,144-tick mask (3 levels). Short gaps stay in the word; longer ones climb the summary
+// levels, or with ORDERBOOK_SIMD_WORD_SCAN are first looked for by a vector probe of the
+// next words (label: kernel used, or "climb")
+static void gapArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("gap");
+    for (int gap : {1, 16, 64, 128, 256, 512, 1024, 4096, 32768}) {
+        b->Arg(gap);
+    }
+}
+
+template <bool ASCENDING>
+static void BM_BitmaskScan(benchmark::State& state) {
+    const size_t SIZE = 1 << 18;
+    const size_t gap = static_cast<size_t>(state.range(0));
+    Bitmask mask(SIZE);
+    for (size_t p = 0; p < SIZE; p += gap) {
+        mask.set(p);
+    }
+
+    size_t pos = 0;
+    for (auto _ : state) {
+        long long next = ASCENDING ? mask.scanAsc(pos + 1) : mask.scanDesc(pos - 1);
+        if (next == -1)
+            next = ASCENDING ? 0 : static_cast<long long>((SIZE - 1) / gap * gap);
+        pos = static_cast<size_t>(next);
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetLabel(BITMASK_PROBE_WORDS ? WORD_SCAN_KERNEL : "climb");
+}
+BENCHMARK_TEMPLATE(BM_BitmaskScan, true)->Apply(gapArgs);
+BENCHMARK_TEMPLATE(BM_BitmaskScan, false)->Apply(gapArgs);
+
+// The word-scan kernels alone: first non-zero word after `gap` empty ones
+enum class ScanKernel { SCALAR, AVX2, AVX512 };
+
+template <ScanKernel K>
+static void BM_WordScan(benchmark::State& state) {
+    const size_t gap = static_cast<size_t>(state.range(0));
+    std::vector<std::uint64_t> words(gap + 64, 0);
+    words[gap] = 1;
+
+    for (auto _ : state) {
+        long long hit = -1;
+        if constexpr (K == ScanKernel::SCALAR) {
+            hit = firstNonZeroWordScalar(words.data(), 0, words.size());
+        }
+#if defined(__AVX2__)
+        if constexpr (K == ScanKernel::AVX2) {
+            hit = firstNonZeroWordAvx2(words.data(), 0, words.size());
+        }
+#endif
+#if defined(__AVX512F__)
+        if constexpr (K == ScanKernel::AVX512) {
+            hit = firstNonZeroWordAvx512(words.data(), 0, words.size());
+        }
+#endif
+        benchmark::DoNotOptimize(hit);
+    }
+}
+static void wordGapArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("words");
+    for (int gap : {1, 4, 8, 16, 64, 256}) {
+        b->Arg(gap);
+    }
+}
+BENCHMARK_TEMPLATE(BM_WordScan, ScanKernel::SCALAR)->Apply(wordGapArgs);
+#if defined(__AVX2__)
+BENCHMARK_TEMPLATE(BM_WordScan, ScanKernel::AVX2)->Apply(wordGapArgs);
+#endif
+#if defined(__AVX512F__)
+BENCHMARK_TEMPLATE(BM_WordScan, ScanKernel::AVX512)->Apply(wordGapArgs);
+#endif
+
+BENCHMARK_MAIN();
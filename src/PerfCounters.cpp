@@ -0,0 +1,157 @@
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* perfEventName(PerfEvent event) {
+    switch (event) {
+    case PerfEvent::CYCLES:
+        return "cycles";
+    case PerfEvent::INSTRUCTIONS:
+        return "instructions";
+    case PerfEvent::L1D_MISSES:
+        return "L1D misses";
+    case PerfEvent::LLC_MISSES:
+        return "LLC misses";
+    case PerfEvent::BRANCH_MISSES:
+        return "branch misses";
+    case PerfEvent::DTLB_MISSES:
+        return "dTLB misses";
+    default:
+        return "?";
+    }
+}
+
+#ifdef __linux__
+
+namespace {
+
+constexpr std::uint64_t cacheMiss(std::uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// perf type/config for each PerfEvent, in enum order
+struct EventCode {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+constexpr std::array<EventCode, PERF_EVENT_COUNT> EVENT_CODES{{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB)},
+}};
+
+// PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING | ID layout
+struct GroupRead {
+    std::uint64_t count;
+    std::uint64_t timeEnabled;
+    std::uint64_t timeRunning;
+    struct {
+        std::uint64_t value;
+        std::uint64_t id;
+    } events[PERF_EVENT_COUNT];
+};
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    fds.fill(-1);
+
+    int firstErrno = 0;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = EVENT_CODES[i].type;
+        attr.config = EVENT_CODES[i].config;
+        attr.disabled = (leader < 0) ? 1 : 0; // the leader gates the whole group
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING | PERF_FORMAT_ID;
+
+        int fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+        if (fd < 0) {
+            if (firstErrno == 0)
+                firstErrno = errno;
+            continue;
+        }
+
+        if (::ioctl(fd, PERF_EVENT_IOC_ID, &ids[i]) != 0) {
+            ::close(fd);
+            continue;
+        }
+        fds[i] = fd;
+        if (leader < 0)
+            leader = fd;
+    }
+
+    if (leader < 0) {
+        error = std::string("perf_event_open: ") + std::strerror(firstErrno) +
+                " (no PMU, or see /proc/sys/kernel/perf_event_paranoid)";
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0)
+            ::close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    if (leader < 0)
+        return;
+    ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    if (leader < 0)
+        return sample;
+
+    ::ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    GroupRead data;
+    if (::read(leader, &data, sizeof(data)) <= 0 || data.timeRunning == 0)
+        return sample;
+
+    // Group was multiplexed with other users of the PMU: extrapolate to the full window
+    double scale = static_cast<double>(data.timeEnabled) / data.timeRunning;
+
+    for (std::uint64_t n = 0; n < data.count && n < PERF_EVENT_COUNT; n++) {
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            if (fds[i] >= 0 && ids[i] == data.events[n].id) {
+                sample.values[i] = static_cast<std::uint64_t>(data.events[n].value * scale);
+                sample.valid[i] = true;
+            }
+        }
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+    fds.fill(-1);
+    error = "hardware counters need Linux perf_event_open";
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+PerfSample PerfCounters::stop() { return PerfSample(); }
+
+#endif
@@ -0,0 +1,143 @@
+#include "Book.h"
+#include "CommandLog.h"
+#include "Threading.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Replays a binary command log (see CommandLog.h) straight from its mapping into a Book.
+//   replay <file.oblog> [--iterations N] [--latency] [--max-orders N]
+
+const int DEFAULT_ITERATIONS = 5;
+const size_t DEFAULT_MAX_ORDERS = 1'000'000;
+// Latency histogram: 1 ns buckets up to 100 us, everything slower lands in the last bucket
+const size_t LATENCY_BUCKETS = 100'000;
+
+struct ReplayOptions {
+    std::string path;
+    int iterations = DEFAULT_ITERATIONS;
+    bool measureLatency = false;
+    size_t maxOrders = DEFAULT_MAX_ORDERS;
+};
+
+// Returns the smallest latency (ns) at or above quantile `q`
+long long percentile(const std::vector<std::uint64_t>& histogram, std::uint64_t total, double q) {
+    std::uint64_t target = static_cast<std::uint64_t>(q * total);
+    std::uint64_t seen = 0;
+    for (size_t ns = 0; ns < histogram.size(); ns++) {
+        seen += histogram[ns];
+        if (seen > target)
+            return static_cast<long long>(ns);
+    }
+    return static_cast<long long>(histogram.size() - 1);
+}
+
+double replayThroughput(std::span<const Command> records, size_t maxOrders) {
+    BasicBook<NoopListener> book(maxOrders);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (const Command& cmd : records) {
+        book.process(cmd);
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+    return records.size() / duration.count();
+}
+
+// Times every record individually (includes ~20ns of clock overhead per sample)
+void replayLatency(std::span<const Command> records, size_t maxOrders, std::vector<std::uint64_t>& histogram) {
+    BasicBook<NoopListener> book(maxOrders);
+
+    for (const Command& cmd : records) {
+        auto t0 = std::chrono::steady_clock::now();
+        book.process(cmd);
+        auto t1 = std::chrono::steady_clock::now();
+
+        auto ns = static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        histogram[std::min(ns, LATENCY_BUCKETS - 1)]++;
+    }
+}
+
+ReplayOptions parseArgs(int argc, char* argv[]) {
+    ReplayOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--iterations" || arg == "-n") && i + 1 < argc) {
+            options.iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--latency" || arg == "-l") {
+            options.measureLatency = true;
+        } else if (arg == "--max-orders" && i + 1 < argc) {
+            options.maxOrders = std::stoull(argv[++i]);
+        } else {
+            options.path = arg;
+        }
+    }
+
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    ReplayOptions options = parseArgs(argc, argv);
+    if (options.path.empty()) {
+        std::cerr << "usage: replay <file.oblog> [--iterations N] [--latency] [--max-orders N]\n";
+        return 1;
+    }
+
+    pinThreadToCore(0);
+
+    try {
+        auto loadStart = std::chrono::steady_clock::now();
+        CommandLogReader log(options.path);
+        std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - loadStart;
+
+        std::span<const Command> records = log.records();
+        double megabytes = records.size_bytes() / (1024.0 * 1024.0);
+
+        std::cout << "\n============================================\n";
+        std::cout << "             COMMAND LOG REPLAY             \n";
+        std::cout << "============================================\n";
+        std::cout << "File              : " << options.path << "\n";
+        std::cout << "Records           : " << records.size() << " (" << std::fixed << std::setprecision(1)
+                  << megabytes << " MB, mapped in " << std::setprecision(3) << loadTime.count() << "s)\n";
+
+        if (records.empty())
+            return 0;
+
+        std::vector<double> runs;
+        for (int i = 0; i < options.iterations; i++) {
+            runs.push_back(replayThroughput(records, options.maxOrders));
+            std::cout << "Iteration " << std::setw(2) << i << " | Tput: " << std::setw(11)
+                      << static_cast<long long>(runs.back()) << " ops/s\n";
+        }
+
+        double best = *std::max_element(runs.begin(), runs.end());
+        std::cout << "--------------------------------------------\n";
+        std::cout << "Best Throughput   : " << static_cast<long long>(best) << " ops/sec (" << std::setprecision(1)
+                  << 1e9 / best << " ns/op)\n";
+
+        if (options.measureLatency) {
+            std::vector<std::uint64_t> histogram(LATENCY_BUCKETS, 0);
+            replayLatency(records, options.maxOrders, histogram);
+
+            std::cout << "P50 Latency       : " << percentile(histogram, records.size(), 0.50) << " ns\n";
+            std::cout << "P99 Latency       : " << percentile(histogram, records.size(), 0.99) << " ns\n";
+            std::cout << "P99.9 Latency     : " << percentile(histogram, records.size(), 0.999) << " ns\n";
+            std::cout << "Max Latency       : " << (histogram.back() ? ">= " : "")
+                      << percentile(histogram, records.size(), 1.0) + (histogram.back() ? 1 : 0) << " ns\n";
+        }
+        std::cout << "============================================\n";
+    } catch (const std::exception& e) {
+        std::cerr << "replay: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
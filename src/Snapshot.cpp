@@ -0,0 +1,98 @@
+#include "Snapshot.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+} // namespace
+
+SnapshotWriter::SnapshotWriter(const std::string& path)
+{
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot create snapshot: " + path);
+    }
+    pending.reserve(WRITE_BUFFER_SIZE);
+
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.lowestAsk = MAX_PRICE;
+    write(&header, sizeof(header));
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    if (!file)
+        return;
+    // Abandoned without close(): leave an unfinalised (count-less) file behind
+    std::fclose(file);
+}
+
+void SnapshotWriter::write(const void* data, size_t bytes) {
+    if (pending.size() + bytes > WRITE_BUFFER_SIZE) {
+        flush();
+        // Larger than the whole buffer: hand it to stdio directly
+        if (bytes > WRITE_BUFFER_SIZE) {
+            if (std::fwrite(data, bytes, 1, file) != 1) {
+                throw std::runtime_error("snapshot write failed");
+            }
+            return;
+        }
+    }
+    size_t at = pending.size();
+    pending.resize(at + bytes);
+    std::memcpy(pending.data() + at, data, bytes);
+}
+
+void SnapshotWriter::flush() {
+    if (!pending.empty() && std::fwrite(pending.data(), pending.size(), 1, file) != 1) {
+        throw std::runtime_error("snapshot write failed");
+    }
+    pending.clear();
+}
+
+void SnapshotWriter::writeLevel(Side side, Price price, const SnapshotOrder* orders, std::uint32_t orderCount) {
+    if (side == Side::BUY) {
+        header.bidLevels++;
+    } else {
+        header.askLevels++;
+    }
+    header.orderCount += orderCount;
+
+    SnapshotLevel level{price, orderCount};
+    write(&level, sizeof(level));
+    write(orders, orderCount * sizeof(SnapshotOrder));
+}
+
+void SnapshotWriter::writeStopLevel(Side side, Price trigger, const SnapshotStop* stops, std::uint32_t stopCount) {
+    if (side == Side::BUY) {
+        header.buyStopLevels++;
+    } else {
+        header.sellStopLevels++;
+    }
+    header.stopCount += stopCount;
+
+    SnapshotLevel level{trigger, stopCount};
+    write(&level, sizeof(level));
+    write(stops, stopCount * sizeof(SnapshotStop));
+}
+
+void SnapshotWriter::close(Price highestBid, Price lowestAsk, Price lastTradePrice) {
+    if (!file)
+        return;
+
+    header.highestBid = highestBid;
+    header.lowestAsk = lowestAsk;
+    header.lastTradePrice = lastTradePrice;
+    flush();
+
+    bool ok = std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+
+    if (!ok) {
+        throw std::runtime_error("snapshot close failed");
+    }
+}
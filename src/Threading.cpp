@@ -0,0 +1,33 @@
+#include "Threading.h"
+#include <iostream>
+#include <pthread.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+void pinThreadToCore([[maybe_unused]] int core_id) {
+#if defined(__linux__)
+    // LINUX: Strict Pinning (Locks thread to specific CPU ID)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+
+    pthread_t current_thread = pthread_self();
+    int rc = pthread_setaffinity_np(current_thread, sizeof(cpu_set_t), &cpuset);
+
+    if (rc != 0) {
+        std::cerr << "[Linux] Warning: Failed to pin to Core " << core_id << "\n";
+    } else {
+        std::cout << "[Linux] Optimization: Thread pinned to Core " << core_id << "\n";
+    }
+#elif defined(__APPLE__)
+    // Hints scheduler to use performance cores over efficiency cores
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+    std::cout << "[macOS] Optimization: QoS set to USER_INTERACTIVE (Performance Cores)\n";
+#else
+    // WINDOWS / OTHER
+    std::cout << "[System] Optimization: Pinning not supported on this OS.\n";
+#endif
+}
@@ -0,0 +1,32 @@
+#include "Tsc.h"
+
+#include <chrono>
+
+namespace {
+
+double calibrate() {
+#if defined(__x86_64__) || defined(__i386__)
+    using Clock = std::chrono::steady_clock;
+    const auto window = std::chrono::milliseconds(10);
+
+    auto wallStart = Clock::now();
+    std::uint64_t tscBegin = tscStart();
+    auto wallEnd = wallStart;
+    while (wallEnd - wallStart < window) {
+        wallEnd = Clock::now();
+    }
+    std::uint64_t tscEnd = tscStop();
+
+    double nanos = std::chrono::duration<double, std::nano>(wallEnd - wallStart).count();
+    return nanos / static_cast<double>(tscEnd - tscBegin);
+#else
+    return 1.0;
+#endif
+}
+
+} // namespace
+
+double tscNanosPerTick() {
+    static const double nanosPerTick = calibrate();
+    return nanosPerTick;
+}
@@ -0,0 +1,135 @@
+#include "Bitmask.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+TEST(BitmaskTest, EmptyMask_ScansFindNothing) {
+    Bitmask mask(100'000);
+
+    EXPECT_TRUE(mask.empty());
+    EXPECT_EQ(mask.scanAsc(0), -1);
+    EXPECT_EQ(mask.scanDesc(99'999), -1);
+}
+
+TEST(BitmaskTest, FarApartLevels_AreFoundAcrossSummaryWords) {
+    Bitmask mask(100'000);
+    mask.set(3);
+    mask.set(99'998);
+
+    // Ascending skips ~1,560 empty leaf words
+    EXPECT_EQ(mask.scanAsc(4), 99'998);
+    // Descending does the same in reverse
+    EXPECT_EQ(mask.scanDesc(99'997), 3);
+
+    mask.unset(3);
+    EXPECT_EQ(mask.scanDesc(99'997), -1);
+    EXPECT_FALSE(mask.empty());
+
+    mask.unset(99'998);
+    EXPECT_TRUE(mask.empty());
+}
+
+TEST(BitmaskTest, Unset_KeepsSummaryWhileSiblingsRemain) {
+    Bitmask mask(4096);
+    mask.set(64);
+    mask.set(65);
+
+    mask.unset(64);
+    EXPECT_TRUE(mask.test(65));
+    EXPECT_EQ(mask.scanAsc(0), 65);
+    EXPECT_EQ(mask.scanDesc(4095), 65);
+}
+
+TEST(BitmaskTest, RandomizedScans_MatchReferenceSet) {
+    constexpr size_t SIZE = 300'000; // Three summary levels + leaves
+    Bitmask mask(SIZE);
+    std::set<size_t> reference;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> priceDist(0, SIZE - 1);
+
+    for (int i = 0; i < 20'000; i++) {
+        size_t p = priceDist(rng);
+        if (rng() % 3 == 0) {
+            mask.unset(p);
+            reference.erase(p);
+        } else {
+            mask.set(p);
+            reference.insert(p);
+        }
+
+        size_t probe = priceDist(rng);
+
+        auto up = reference.lower_bound(probe);
+        long long expectedAsc = (up == reference.end()) ? -1 : static_cast<long long>(*up);
+        ASSERT_EQ(mask.scanAsc(probe), expectedAsc);
+
+        auto down = reference.upper_bound(probe);
+        long long expectedDesc = (down == reference.begin()) ? -1 : static_cast<long long>(*std::prev(down));
+        ASSERT_EQ(mask.scanDesc(probe), expectedDesc);
+    }
+}
+
+TEST(BitmaskTest, SparseScans_AcrossProbeAndClimbDistances) {
+    // Few levels, so gaps span the in-word, vector-probe and climb paths of every level
+    constexpr size_t SIZE = 300'000;
+    Bitmask mask(SIZE);
+    std::set<size_t> reference;
+
+    std::mt19937 rng(22);
+    std::uniform_int_distribution<size_t> priceDist(0, SIZE - 1);
+    for (int i = 0; i < 40; i++) {
+        size_t p = priceDist(rng);
+        mask.set(p);
+        reference.insert(p);
+    }
+
+    for (int i = 0; i < 20'000; i++) {
+        // Probe near a set bit half of the time (short gaps), anywhere otherwise
+        size_t probe = priceDist(rng);
+        if (rng() % 2) {
+            auto it = reference.lower_bound(probe);
+            size_t anchor = (it == reference.end()) ? *reference.begin() : *it;
+            size_t offset = rng() % 2048;
+            probe = (rng() % 2) ? std::min(anchor + offset, SIZE - 1) : (anchor > offset ? anchor - offset : 0);
+        }
+
+        auto up = reference.lower_bound(probe);
+        ASSERT_EQ(mask.scanAsc(probe), (up == reference.end()) ? -1 : static_cast<long long>(*up)) << probe;
+
+        auto down = reference.upper_bound(probe);
+        ASSERT_EQ(mask.scanDesc(probe), (down == reference.begin()) ? -1 : static_cast<long long>(*std::prev(down)))
+            << probe;
+    }
+}
+
+TEST(WordScanTest, Kernels_MatchScalarOnEveryRange) {
+    std::vector<std::uint64_t> words(40, 0);
+    std::mt19937_64 rng(3);
+
+    for (int round = 0; round < 200; round++) {
+        std::fill(words.begin(), words.end(), 0);
+        for (int k = rng() % 4; k > 0; k--) {
+            words[rng() % words.size()] = rng() | 1;
+        }
+
+        for (size_t begin = 0; begin <= words.size(); begin++) {
+            for (size_t end = begin; end <= words.size(); end++) {
+                long long first = firstNonZeroWordScalar(words.data(), begin, end);
+                long long last = lastNonZeroWordScalar(words.data(), begin, end);
+                ASSERT_EQ(firstNonZeroWord(words.data(), begin, end), first);
+                ASSERT_EQ(lastNonZeroWord(words.data(), begin, end), last);
+#if defined(__AVX2__)
+                ASSERT_EQ(firstNonZeroWordAvx2(words.data(), begin, end), first);
+                ASSERT_EQ(lastNonZeroWordAvx2(words.data(), begin, end), last);
+#endif
+#if defined(__AVX512F__)
+                ASSERT_EQ(firstNonZeroWordAvx512(words.data(), begin, end), first);
+                ASSERT_EQ(lastNonZeroWordAvx512(words.data(), begin, end), last);
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "Book.h"
+#include "CommandLog.h"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class CommandLogTest : public ::testing::Test {
+protected:
+    std::string path = (std::filesystem::temp_directory_path() / "CommandLogTest.oblog").string();
+
+    void TearDown() override { std::remove(path.c_str()); }
+};
+
+TEST_F(CommandLogTest, RoundTrip_PreservesRecordsInOrder) {
+    std::vector<Command> cmds{
+        {1, 100, 10, OrderType::LIMIT, Side::SELL},
+        {2, 101, 5, OrderType::LIMIT, Side::BUY},
+        {1, 0, 0, OrderType::CANCEL, Side::BUY},
+        {3, 0, 7, OrderType::MARKET, Side::BUY},
+        {0xFFFFFFFFFFFFFFFFULL, 99, 3, OrderType::MODIFY, Side::SELL},
+    };
+
+    {
+        CommandLogWriter writer(path);
+        writer.append(cmds);
+        EXPECT_EQ(writer.getRecordCount(), cmds.size());
+    }
+
+    CommandLogReader reader(path);
+    auto records = reader.records();
+    ASSERT_EQ(records.size(), cmds.size());
+
+    for (size_t i = 0; i < cmds.size(); i++) {
+        EXPECT_EQ(records[i].id, cmds[i].id);
+        EXPECT_EQ(records[i].price, cmds[i].price);
+        EXPECT_EQ(records[i].qty, cmds[i].qty);
+        EXPECT_EQ(records[i].type, cmds[i].type);
+        EXPECT_EQ(records[i].side, cmds[i].side);
+    }
+}
+
+TEST_F(CommandLogTest, MappedRecords_DriveBookDirectly) {
+    {
+        CommandLogWriter writer(path);
+        writer.append({1, 100, 10, OrderType::LIMIT, Side::SELL});
+        writer.append({2, 100, 4, OrderType::LIMIT, Side::BUY});
+    }
+
+    CommandLogReader reader(path);
+    Book book(16);
+    for (const Command& cmd : reader.records()) {
+        book.process(cmd);
+    }
+
+    DepthLevel best{};
+    ASSERT_EQ(book.getDepth(Side::SELL, &best, 1), 1);
+    EXPECT_EQ(best.qty, 6);
+}
+
+TEST_F(CommandLogTest, ForeignOrTruncatedFile_Throws) {
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        std::fputs("definitely not a command log, just some text", f);
+        std::fclose(f);
+    }
+    EXPECT_THROW(CommandLogReader{path}, std::runtime_error);
+
+    {
+        CommandLogWriter writer(path);
+        writer.append({1, 100, 10, OrderType::LIMIT, Side::SELL});
+        writer.append({2, 100, 10, OrderType::LIMIT, Side::SELL});
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(CommandLogReader{path}, std::runtime_error);
+
+    EXPECT_THROW(CommandLogReader{path + ".missing"}, std::runtime_error);
+}
@@ -0,0 +1,155 @@
+#include "Book.h"
+#include "CompactBook.h"
+#include "TestFlows.h"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+struct RecordingListener {
+    std::vector<Trade> trades;
+    void onTrade(const Trade& trade) { trades.push_back(trade); }
+};
+
+bool sameDepth(const DepthLevel& a, const DepthLevel& b) {
+    return a.price == b.price && a.qty == b.qty && a.orderCount == b.orderCount;
+}
+
+} // namespace
+
+TEST(CompactBookTest, FifoWithinLevel_AndLevelEmptiedFlag) {
+    CompactBook<RecordingListener> book(16, 1, 1000);
+    book.addLimitOrder(1, 100, 5, Side::SELL);
+    book.addLimitOrder(2, 100, 5, Side::SELL);
+    book.addLimitOrder(3, 101, 5, Side::SELL);
+
+    book.addLimitOrder(10, 101, 12, Side::BUY);
+
+    const auto& trades = book.getListener().trades;
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades[0].makerOrderId, 1);
+    EXPECT_EQ(trades[1].makerOrderId, 2);
+    EXPECT_TRUE(trades[1].levelEmptied);
+    EXPECT_EQ(trades[2].makerOrderId, 3);
+    EXPECT_EQ(trades[2].makerRemaining, 3);
+    EXPECT_EQ(book.getBestAsk(), 101);
+    EXPECT_EQ(book.getBestBid(), std::nullopt);
+    EXPECT_EQ(book.getOrderQty(3), 3);
+}
+
+TEST(CompactBookTest, CancelledSlotsAreReused) {
+    CompactBook<> book(4, 1, 1000);
+    for (OrderId id = 1; id <= 1000; id++) {
+        book.addLimitOrder(id, 100 + id % 50, 1, Side::BUY);
+        book.cancelOrder(id);
+    }
+    EXPECT_EQ(book.getOrderCount(), 0);
+    EXPECT_EQ(book.getBestBid(), std::nullopt);
+
+    book.addLimitOrder(5000, 100, 1, Side::BUY);
+    EXPECT_EQ(book.getOrderCount(), 1);
+    EXPECT_EQ(book.getOrderQty(5000), 1);
+}
+
+TEST(CompactBookTest, RejectsPricesOutsideBand) {
+    CompactBook<> book(4, 100, 200);
+    EXPECT_THROW(book.addLimitOrder(1, 99, 1, Side::BUY), std::out_of_range);
+    EXPECT_THROW(book.addLimitOrder(1, 201, 1, Side::SELL), std::out_of_range);
+    EXPECT_EQ(book.getOrderCount(), 0);
+
+    book.addLimitOrder(2, 150, 1, Side::BUY);
+    EXPECT_THROW(book.modifyOrder(2, 300, 1), std::out_of_range);
+    EXPECT_EQ(book.getOrderQty(2), 1);
+
+    EXPECT_THROW(CompactBook<>(4, 0, 10), std::invalid_argument);
+}
+
+TEST(CompactBookTest, Modify_PostOnlyThroughSpread_IsIgnored) {
+    CompactBook<RecordingListener> book(16, 1, 1000);
+    book.addLimitOrder(1, 105, 5, Side::SELL);
+    ASSERT_TRUE(book.addPostOnlyOrder(2, 100, 8, Side::BUY));
+
+    book.modifyOrder(2, 106, 8);
+
+    EXPECT_TRUE(book.getListener().trades.empty());
+    EXPECT_EQ(book.getBestAsk(), 105);
+    EXPECT_EQ(book.getBestBid(), 100);
+    EXPECT_EQ(book.getOrderQty(2), 8);
+
+    // The flag belongs to the order, not the slot: a plain limit reusing it still crosses
+    book.cancelOrder(2);
+    book.addLimitOrder(3, 100, 2, Side::BUY);
+    book.modifyOrder(3, 105, 2);
+    EXPECT_EQ(book.getListener().trades.size(), 1);
+    EXPECT_EQ(book.getOrderQty(1), 3);
+}
+
+// Random limit / market / IOC / FOK / post-only / cancel / modify flow: both layouts
+// must emit the same fills
+// and end every step with the same touch, and the same depth at the end
+TEST(CompactBookTest, RandomFlow_MatchesBasicBook) {
+    const Price MID = 10'000;
+    BasicBook<RecordingListener> reference(1 << 12);
+    CompactBook<RecordingListener> compact(1 << 12, MID - 1'000, MID + 1'000);
+
+    std::mt19937 rng(19);
+    std::vector<OrderId> live;
+    OrderId nextId = 1;
+
+    for (int i = 0; i < 100'000; i++) {
+        Command cmd{};
+        unsigned roll = rng() % 100;
+        Side side = (rng() % 2) ? Side::BUY : Side::SELL;
+        // Overlapping bands around MID, so limits cross regularly
+        Price price = (side == Side::BUY) ? MID - 60 + rng() % 80 : MID - 20 + rng() % 80;
+
+        if (roll < 45 || live.empty()) {
+            cmd = {nextId, price, 1 + static_cast<Quantity>(rng() % 20), OrderType::LIMIT, side};
+            live.push_back(nextId++);
+        } else if (roll < 50) {
+            cmd = {nextId++, 0, 1 + static_cast<Quantity>(rng() % 40), OrderType::MARKET, side};
+        } else if (roll < 56) {
+            OrderType type = (roll < 53) ? OrderType::IOC : OrderType::FOK;
+            cmd = {nextId++, price, 1 + static_cast<Quantity>(rng() % 60), type, side};
+        } else if (roll < 60) {
+            // Rejected post-only orders leave a dead id behind (cancel is a no-op)
+            cmd = {nextId, price, 1 + static_cast<Quantity>(rng() % 20), OrderType::POST_ONLY, side};
+            live.push_back(nextId++);
+        } else if (roll < 85) {
+            size_t pick = rng() % live.size();
+            cmd = {live[pick], 0, 0, OrderType::CANCEL, Side::BUY};
+            live[pick] = live.back();
+            live.pop_back();
+        } else {
+            // Ids that already traded away are no-ops in both books
+            OrderId id = live[rng() % live.size()];
+            cmd = {id, price, static_cast<Quantity>(rng() % 20), OrderType::MODIFY, side};
+        }
+
+        reference.process(cmd);
+        compact.process(cmd);
+
+        ASSERT_EQ(reference.getBestBid(), compact.getBestBid()) << "step " << i;
+        ASSERT_EQ(reference.getBestAsk(), compact.getBestAsk()) << "step " << i;
+    }
+
+    const auto& expected = reference.getListener().trades;
+    const auto& actual = compact.getListener().trades;
+    ASSERT_GT(expected.size(), 1000);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_TRUE(sameTrade(expected[i], actual[i])) << "trade " << i;
+    }
+
+    for (Side side : {Side::BUY, Side::SELL}) {
+        DepthLevel want[MAX_DEPTH_LEVELS], got[MAX_DEPTH_LEVELS];
+        size_t n = reference.getDepth(side, want, MAX_DEPTH_LEVELS);
+        ASSERT_EQ(compact.getDepth(side, got, MAX_DEPTH_LEVELS), n);
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_TRUE(sameDepth(want[i], got[i])) << "level " << i;
+        }
+    }
+}
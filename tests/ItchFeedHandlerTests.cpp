@@ -0,0 +1,107 @@
+#include "ItchFeedHandler.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+DepthLevel topOf(const BasicBook<NoopListener>& book, Side side) {
+    DepthLevel level{};
+    book.getDepth(side, &level, 1);
+    return level;
+}
+
+} // namespace
+
+TEST(ItchFeedHandlerTest, BigEndianLoads) {
+    const std::uint8_t bytes[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+    EXPECT_EQ(itch::load16(bytes), 0x0102);
+    EXPECT_EQ(itch::load32(bytes), 0x01020304u);
+    EXPECT_EQ(itch::load64(bytes), 0x0102030405060708ULL);
+}
+
+TEST(ItchFeedHandlerTest, OrderLifecycle_AppliedToBookOfItsLocate) {
+    itch::Encoder feed;
+    feed.systemEvent('O');
+    feed.addOrder(7, 100, Side::BUY, 300, 1'000'000);
+    feed.addOrder(7, 101, Side::SELL, 200, 1'000'100, 0, true);
+    feed.addOrder(9, 102, Side::BUY, 50, 500'000);
+    feed.orderExecuted(7, 100, 100);
+    feed.orderCancel(7, 100, 50);
+    feed.orderExecutedWithPrice(7, 101, 20, 1'000'050);
+    feed.orderReplace(7, 101, 103, 500, 1'000'200);
+    feed.orderDelete(9, 102);
+
+    ItchFeedHandler<> handler;
+    EXPECT_EQ(handler.processStream(feed.bytes()), feed.bytes().size());
+
+    const auto* book = handler.getBook(7);
+    ASSERT_NE(book, nullptr);
+    EXPECT_EQ(topOf(*book, Side::BUY).qty, 150);
+    EXPECT_EQ(topOf(*book, Side::SELL).price, 1'000'200u);
+    EXPECT_EQ(topOf(*book, Side::SELL).qty, 500);
+
+    ASSERT_NE(handler.getBook(9), nullptr);
+    EXPECT_FALSE(handler.getBook(9)->getBestBid().has_value());
+    EXPECT_EQ(handler.getBookCount(), 2);
+
+    const auto& stats = handler.getStats();
+    EXPECT_EQ(stats.messages, 9);
+    EXPECT_EQ(stats.adds, 3);
+    EXPECT_EQ(stats.executions, 2);
+    EXPECT_EQ(stats.cancels, 1);
+    EXPECT_EQ(stats.deletes, 1);
+    EXPECT_EQ(stats.replaces, 1);
+    EXPECT_EQ(stats.skipped, 1);
+    EXPECT_EQ(stats.malformed, 0);
+}
+
+TEST(ItchFeedHandlerTest, CrossedAdd_RestsUntilItsExecutionArrives) {
+    // Pre-open the feed book can lock / cross: adds must rest, not trade locally
+    itch::Encoder feed;
+    feed.addOrder(7, 100, Side::SELL, 300, 1'000'000);
+    feed.addOrder(7, 101, Side::BUY, 200, 1'000'100);
+    feed.orderExecuted(7, 101, 150);
+    feed.orderReplace(7, 100, 102, 100, 999'900);
+
+    ItchFeedHandler<> handler;
+    handler.processStream(feed.bytes());
+
+    const auto* book = handler.getBook(7);
+    ASSERT_NE(book, nullptr);
+    EXPECT_FALSE(book->getLastTradePrice().has_value());
+    EXPECT_EQ(topOf(*book, Side::BUY).price, 1'000'100u);
+    EXPECT_EQ(topOf(*book, Side::BUY).qty, 50);
+    // The replace crosses further and still rests
+    EXPECT_EQ(topOf(*book, Side::SELL).price, 999'900u);
+    EXPECT_EQ(topOf(*book, Side::SELL).qty, 100);
+}
+
+TEST(ItchFeedHandlerTest, PartialFrame_IsLeftForTheNextBuffer) {
+    itch::Encoder feed;
+    feed.addOrder(1, 1, Side::BUY, 10, 100);
+    feed.addOrder(1, 2, Side::BUY, 10, 100);
+    const auto& bytes = feed.bytes();
+
+    ItchFeedHandler<> handler;
+    size_t split = bytes.size() - 5;
+    size_t consumed = handler.processStream({bytes.data(), split});
+    EXPECT_EQ(consumed, 2 + itch::ADD_ORDER_LEN);
+    EXPECT_EQ(handler.getStats().adds, 1);
+
+    handler.processStream({bytes.data() + consumed, bytes.size() - consumed});
+    EXPECT_EQ(topOf(*handler.getBook(1), Side::BUY).orderCount, 2);
+}
+
+TEST(ItchFeedHandlerTest, TruncatedOrderMessage_IsCountedNotApplied) {
+    itch::Encoder feed;
+    feed.addOrder(1, 1, Side::BUY, 10, 100);
+
+    ItchFeedHandler<> handler;
+    // Unframed body cut short of its fixed layout
+    EXPECT_FALSE(handler.onMessage(feed.bytes().data() + 2, itch::ADD_ORDER_LEN - 1));
+    EXPECT_EQ(handler.getStats().malformed, 1);
+    EXPECT_EQ(handler.getBook(1), nullptr);
+}
@@ -0,0 +1,81 @@
+#include "Journal.h"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+class JournalTest : public ::testing::TestWithParam<JournalBackend> {
+protected:
+    std::string path = (std::filesystem::temp_directory_path() / "JournalTest.objournal").string();
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    JournalConfig smallConfig() const {
+        JournalConfig cfg;
+        cfg.queueCapacity = 64; // forces the producer to wait on the writer
+        cfg.batchBytes = 10 * sizeof(JournalRecord);
+        cfg.syncBytes = 50 * sizeof(JournalRecord);
+        cfg.backend = GetParam();
+        return cfg;
+    }
+};
+
+TEST_P(JournalTest, RoundTrip_SequencedAndDurableAfterStop) {
+    constexpr std::uint64_t N = 5000;
+    {
+        Journal journal(path, smallConfig());
+        for (std::uint64_t i = 0; i < N; i++) {
+            Command cmd{i, static_cast<Price>(100 + i % 7), static_cast<Quantity>(1 + i % 5), OrderType::LIMIT,
+                        (i & 1) ? Side::BUY : Side::SELL};
+            EXPECT_EQ(journal.append(cmd), i + 1);
+        }
+        journal.stop();
+
+        EXPECT_FALSE(journal.hasFailed());
+        EXPECT_EQ(journal.getDurableSequence(), N);
+        EXPECT_EQ(journal.getStats().records, N);
+        EXPECT_GE(journal.getStats().syncs, 1u);
+    }
+
+    JournalReader reader(path);
+    auto records = reader.records();
+    ASSERT_EQ(records.size(), N);
+    for (std::uint64_t i = 0; i < N; i++) {
+        EXPECT_EQ(records[i].sequence, i + 1);
+        EXPECT_EQ(records[i].command.id, i);
+        EXPECT_EQ(records[i].command.price, static_cast<Price>(100 + i % 7));
+        EXPECT_EQ(records[i].command.qty, static_cast<Quantity>(1 + i % 5));
+        EXPECT_EQ(records[i].command.side, (i & 1) ? Side::BUY : Side::SELL);
+    }
+}
+
+TEST_P(JournalTest, TornTail_IsIgnored) {
+    {
+        Journal journal(path, smallConfig());
+        for (std::uint64_t i = 0; i < 3; i++) {
+            journal.append({i, 100, 1, OrderType::LIMIT, Side::SELL});
+        }
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 5);
+
+    JournalReader reader(path);
+    ASSERT_EQ(reader.size(), 2u);
+    EXPECT_EQ(reader.records()[1].sequence, 2u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, JournalTest, ::testing::Values(JournalBackend::PWRITE, JournalBackend::AUTO));
+
+TEST(JournalReaderTest, ForeignFile_Throws) {
+    std::string path = (std::filesystem::temp_directory_path() / "JournalReaderTest.bin").string();
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        std::fputs("definitely not a journal file", f);
+        std::fclose(f);
+    }
+    EXPECT_THROW(JournalReader{path}, std::runtime_error);
+    std::remove(path.c_str());
+
+    EXPECT_THROW(JournalReader{path}, std::runtime_error);
+}
@@ -0,0 +1,72 @@
+#include "Book.h"
+#include "LatencyHistogram.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+TEST(LatencyHistogramTest, Buckets_AreContiguousAndTight) {
+    // Every value maps into a bucket whose range contains it, bucket ranges tile the
+    // value space, and the relative width stays within 1 / SUB_COUNT
+    for (size_t b = 0; b + 1 < LatencyHistogram::BUCKET_COUNT; b++) {
+        std::uint64_t low = LatencyHistogram::bucketLow(b);
+        std::uint64_t high = LatencyHistogram::bucketHigh(b);
+        ASSERT_EQ(LatencyHistogram::bucketOf(low), b);
+        ASSERT_EQ(LatencyHistogram::bucketOf(high), b);
+        ASSERT_EQ(LatencyHistogram::bucketLow(b + 1), high + 1);
+        ASSERT_LE(static_cast<double>(high - low), static_cast<double>(low) / LatencyHistogram::SUB_COUNT);
+    }
+    EXPECT_EQ(LatencyHistogram::bucketOf(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles_WithinBucketPrecision) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.percentile(0.5), 0u);
+
+    for (std::uint64_t v = 1; v <= 10'000; v++) {
+        h.record(v);
+    }
+
+    EXPECT_EQ(h.getCount(), 10'000u);
+    EXPECT_EQ(h.getMax(), 10'000u);
+    EXPECT_DOUBLE_EQ(h.getMean(), 5'000.5);
+    EXPECT_NEAR(static_cast<double>(h.percentile(0.50)), 5'000, 5'000 / 32.0);
+    EXPECT_NEAR(static_cast<double>(h.percentile(0.99)), 9'900, 9'900 / 32.0);
+    EXPECT_EQ(h.percentile(1.0), 10'000u);
+
+    LatencyHistogram other;
+    other.record(1'000'000);
+    h.merge(other);
+    EXPECT_EQ(h.getCount(), 10'001u);
+    EXPECT_EQ(h.getMax(), 1'000'000u);
+
+    h.reset();
+    EXPECT_EQ(h.getCount(), 0u);
+    EXPECT_EQ(h.getMax(), 0u);
+}
+
+TEST(LatencyHistogramTest, Book_TimesProcessPerOperation) {
+    BasicBook<NoopListener> book(64);
+    EXPECT_EQ(book.getLatencyStats(), nullptr);
+
+    // Untimed while disabled
+    book.process({1, 100, 10, OrderType::LIMIT, Side::SELL});
+
+    book.enableLatencyStats(true);
+    book.process({2, 101, 10, OrderType::LIMIT, Side::SELL}); // rests
+    book.process({3, 99, 10, OrderType::LIMIT, Side::BUY});   // rests
+    book.process({4, 100, 4, OrderType::LIMIT, Side::BUY});   // crosses
+    book.process({5, 0, 2, OrderType::MARKET, Side::BUY});
+    book.process({2, 0, 0, OrderType::CANCEL, Side::SELL});
+    book.process({3, 98, 10, OrderType::MODIFY, Side::BUY});
+
+    const OperationLatency* stats = book.getLatencyStats();
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ((*stats)[LatencyOp::LIMIT_REST].getCount(), 2u);
+    EXPECT_EQ((*stats)[LatencyOp::LIMIT_MATCH].getCount(), 1u);
+    EXPECT_EQ((*stats)[LatencyOp::MARKET].getCount(), 1u);
+    EXPECT_EQ((*stats)[LatencyOp::CANCEL].getCount(), 1u);
+    EXPECT_EQ((*stats)[LatencyOp::MODIFY].getCount(), 1u);
+
+    book.enableLatencyStats(false);
+    EXPECT_EQ(book.getLatencyStats(), nullptr);
+}
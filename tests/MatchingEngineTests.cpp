@@ -0,0 +1,54 @@
+#include "MatchingEngine.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(MatchingEngineTest, Symbols_ArePartitionedAcrossShards) {
+    MatchingEngine engine(10, 3, 100);
+
+    EXPECT_EQ(engine.getShardCount(), 3);
+    EXPECT_EQ(engine.shardFor(0), 0);
+    EXPECT_EQ(engine.shardFor(4), 1);
+    EXPECT_EQ(engine.shardFor(8), 2);
+}
+
+TEST(MatchingEngineTest, Submit_RejectsUnknownSymbol) {
+    MatchingEngine engine(4, 2, 100);
+    engine.start(0);
+
+    EXPECT_TRUE(engine.submit(3, {1, 100, 10, OrderType::LIMIT, Side::SELL}));
+    EXPECT_FALSE(engine.submit(4, {2, 100, 10, OrderType::LIMIT, Side::SELL}));
+    EXPECT_FALSE(engine.submit(1000, {3, 100, 10, OrderType::LIMIT, Side::SELL}));
+
+    engine.stop();
+    EXPECT_EQ(engine.getBook(3).getBestAsk(), 100);
+    EXPECT_EQ(engine.getBook(0).getBestAsk(), std::nullopt);
+}
+
+TEST(MatchingEngineTest, Commands_AreRoutedToOwningBook) {
+    constexpr SymbolId SYMBOLS = 8;
+    MatchingEngine engine(SYMBOLS, 2, 1000);
+    engine.start(0);
+
+    auto submit = [&](SymbolId symbol, const Command& cmd) {
+        while (!engine.submit(symbol, cmd)) {
+            std::this_thread::yield();
+        }
+    };
+
+    // Same order ids on every symbol: books must stay independent
+    for (SymbolId s = 0; s < SYMBOLS; s++) {
+        submit(s, {1, 100, 10, OrderType::LIMIT, Side::SELL});
+        submit(s, {2, 100, 10 + s, OrderType::LIMIT, Side::BUY});
+    }
+
+    engine.stop();
+
+    // Symbol 0: exact cross, Symbol s > 0: buyer rests with `s` left over
+    int tradesSeen = 0;
+    for (SymbolId s = 0; s < SYMBOLS; s++) {
+        Book& book = engine.getBook(s);
+        book.setTradeCallback([&](const Trade&) { tradesSeen++; });
+        book.addMarketOrder(3, 1000, Side::SELL);
+    }
+    EXPECT_EQ(tradesSeen, SYMBOLS - 1);
+}
@@ -1,6 +1,15 @@
 #include "Book.h"
+#include "TestFlows.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
 class OrderBookTest : public ::testing::Test {
 protected:
     Book book{100000};
@@ -10,32 +19,43 @@ protected:
     // ==========================================
 
     // Checks if an order ID exists
-    bool hasOrder(OrderId id) const { return book.orderMap[id] != nullptr; }
+    bool hasOrder(OrderId id) const { return book.orderMap.find(id) != nullptr; }
 
     // Retrieves a pointer to an order
-    Order* getOrder(OrderId id) const { return book.orderMap[id]; }
+    Order* getOrder(OrderId id) const { return book.orderMap.find(id); }
 
     // Returns number of active Price Levels on the Sell side
-    size_t getAskDepth() const {
-        size_t count = 0;
-        for (const auto* limit : book.asks) {
-            if (limit != nullptr)
-                count++;
-        }
-        return count;
-    }
+    size_t getAskDepth() const { return book.asks.getLevelCount(); }
 
     // Returns number of active Price Levels on the Buy side
-    size_t getBidDepth() const {
-        size_t count = 0;
-        for (const auto* limit : book.bids) {
-            if (limit != nullptr)
-                count++;
-        }
-        return count;
+    size_t getBidDepth() const { return book.bids.getLevelCount(); }
+
+    // Checks whether a price sits in the dense (non-overflow) part of each ladder
+    bool askInWindow(Price price) const { return book.asks.inWindow(price); }
+    bool bidInWindow(Price price) const { return book.bids.inWindow(price); }
+
+    // Top-N levels rebuilt by walking the ladder (reference for the depth cache)
+    std::vector<DepthLevel> walkDepth(Side side, size_t n) const {
+        std::vector<DepthLevel> levels;
+        const auto& ladder = (side == Side::BUY) ? book.bids : book.asks;
+        ladder.forEachLevel([&](const Limit* limit) { levels.push_back({limit->limitPrice, limit->totalVolume, limit->size}); });
+        if (side == Side::BUY)
+            std::reverse(levels.begin(), levels.end());
+        levels.resize(std::min(n, levels.size()));
+        return levels;
+    }
+
+    std::vector<DepthLevel> cachedDepth(Side side, size_t n) const {
+        std::vector<DepthLevel> levels(n);
+        levels.resize(book.getDepth(side, levels.data(), n));
+        return levels;
     }
 };
 
+inline bool operator==(const DepthLevel& a, const DepthLevel& b) {
+    return a.price == b.price && a.qty == b.qty && a.orderCount == b.orderCount;
+}
+
 // =====================================================================
 // SECTION 1: PLACEMENT & STATE
 // Verify orders rest in the book correctly when no match is possible.
@@ -211,6 +231,225 @@ TEST_F(OrderBookTest, MarketBuy_ExceedsLiquidity) {
     EXPECT_EQ(getAskDepth(), 0); // Book is empty
 }
 
+// =====================================================================
+// SECTION 4b: IOC / FOK / POST-ONLY
+// Verify time-in-force handling: nothing rests from IOC / FOK, killed FOKs
+// and rejected post-only orders leave the book untouched.
+// =====================================================================
+
+TEST_F(OrderBookTest, Ioc_FillsUpToLimit_DropsRemainder) {
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 101, 10, Side::SELL);
+    book.addLimitOrder(3, 102, 10, Side::SELL);
+
+    // Takes 100 and 101, stops at its limit; the other 10 are dropped
+    book.addIocOrder(4, 101, 30, Side::BUY);
+
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_FALSE(hasOrder(2));
+    EXPECT_FALSE(hasOrder(4));
+    EXPECT_EQ(book.getBestAsk(), 102);
+    EXPECT_EQ(book.getBestBid(), std::nullopt);
+    EXPECT_EQ(book.getOrderPool().getInUse(), 1);
+}
+
+TEST_F(OrderBookTest, Fok_KilledWithoutTouchingBook) {
+    std::vector<Trade> trades;
+    book.setTradeCallback([&](const Trade& t) { trades.push_back(t); });
+    book.addLimitOrder(1, 99, 10, Side::BUY);
+    book.addLimitOrder(2, 98, 10, Side::BUY);
+    book.addLimitOrder(3, 97, 10, Side::BUY);
+
+    for (bool indexed : {false, true}) {
+        book.enableVolumeIndex(indexed);
+
+        // 30 rest in total, but only 20 down to 98
+        EXPECT_FALSE(book.addFokOrder(4, 98, 21, Side::SELL));
+        EXPECT_FALSE(book.addFokOrder(4, 100, 1, Side::SELL));
+        EXPECT_TRUE(trades.empty());
+        EXPECT_EQ(getOrder(1)->qty, 10);
+        EXPECT_EQ(getBidDepth(), 3);
+        EXPECT_FALSE(hasOrder(4));
+    }
+
+    EXPECT_TRUE(book.addFokOrder(5, 98, 15, Side::SELL));
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[1].price, 98);
+    EXPECT_EQ(trades[1].quantity, 5);
+    EXPECT_EQ(book.getBestBid(), 98);
+    EXPECT_FALSE(hasOrder(5));
+}
+
+TEST_F(OrderBookTest, PostOnly_RejectedOnCross_RestsOtherwise) {
+    std::vector<Trade> trades;
+    book.setTradeCallback([&](const Trade& t) { trades.push_back(t); });
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 95, 10, Side::BUY);
+
+    EXPECT_FALSE(book.addPostOnlyOrder(3, 100, 5, Side::BUY));
+    EXPECT_FALSE(book.addPostOnlyOrder(4, 95, 5, Side::SELL));
+    EXPECT_FALSE(hasOrder(3));
+    EXPECT_FALSE(hasOrder(4));
+    EXPECT_TRUE(trades.empty());
+
+    EXPECT_TRUE(book.addPostOnlyOrder(5, 99, 5, Side::BUY));
+    EXPECT_TRUE(book.addPostOnlyOrder(6, 100, 5, Side::SELL));
+    EXPECT_EQ(book.getBestBid(), 99);
+    EXPECT_EQ(book.getSpread(), 1);
+
+    // Once resting it is an ordinary maker, queued behind order 1
+    book.addMarketOrder(7, 12, Side::BUY);
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[1].makerOrderId, 6);
+    EXPECT_EQ(getOrder(6)->qty, 3);
+}
+
+TEST_F(OrderBookTest, Process_DispatchesTimeInForceTypes) {
+    book.process({1, 100, 10, OrderType::LIMIT, Side::SELL});
+    book.process({2, 100, 4, OrderType::IOC, Side::BUY});
+    book.process({3, 100, 7, OrderType::FOK, Side::BUY});
+    book.process({4, 100, 5, OrderType::POST_ONLY, Side::BUY});
+    book.process({5, 99, 5, OrderType::POST_ONLY, Side::BUY});
+
+    // IOC took 4, the FOK for 7 > 6 was killed, the crossing post-only was rejected
+    EXPECT_EQ(getOrder(1)->qty, 6);
+    EXPECT_FALSE(hasOrder(2));
+    EXPECT_FALSE(hasOrder(3));
+    EXPECT_FALSE(hasOrder(4));
+    EXPECT_EQ(getOrder(5)->qty, 5);
+}
+
+// =====================================================================
+// SECTION 4c: STOP ORDERS
+// Verify stops wait off the book until a trade reaches their trigger, fire in
+// priority order, and cascade without recursion.
+// =====================================================================
+
+TEST_F(OrderBookTest, StopMarket_FiresWhenTradeReachesTrigger) {
+    std::vector<Trade> trades;
+    book.setTradeCallback([&](const Trade& t) { trades.push_back(t); });
+    book.addLimitOrder(1, 100, 5, Side::SELL);
+    book.addLimitOrder(2, 101, 5, Side::SELL);
+    book.addLimitOrder(3, 102, 10, Side::SELL);
+
+    ASSERT_TRUE(book.addStopOrder(10, 101, 10, Side::BUY));
+    // Pending: indexed for cancels, but not on either side of the book
+    EXPECT_TRUE(hasOrder(10));
+    EXPECT_EQ(getBidDepth(), 0);
+
+    book.addMarketOrder(4, 5, Side::BUY);
+    EXPECT_EQ(book.getLastTradePrice(), 100);
+    EXPECT_EQ(trades.size(), 1);
+
+    // Trade at 101 fires the stop: 4 more at 101, then 6 at 102
+    book.addMarketOrder(5, 1, Side::BUY);
+    ASSERT_EQ(trades.size(), 4);
+    EXPECT_EQ(trades[2].takerOrderId, 10);
+    EXPECT_EQ(trades[2].quantity, 4);
+    EXPECT_EQ(trades[3].price, 102);
+    EXPECT_EQ(trades[3].quantity, 6);
+    EXPECT_FALSE(hasOrder(10));
+    EXPECT_EQ(getOrder(3)->qty, 4);
+    EXPECT_EQ(book.getLastTradePrice(), 102);
+}
+
+TEST_F(OrderBookTest, StopLimit_RemainderRestsAsLimit) {
+    book.addLimitOrder(1, 99, 5, Side::BUY);
+    book.addLimitOrder(2, 98, 5, Side::BUY);
+    book.addLimitOrder(3, 97, 10, Side::BUY);
+    ASSERT_TRUE(book.addStopLimitOrder(10, 99, 98, 20, Side::SELL));
+
+    // Sell at 99 fires it: takes the 98 level, then rests 15 at its limit
+    book.addMarketOrder(4, 5, Side::SELL);
+
+    EXPECT_EQ(book.getBestBid(), 97);
+    EXPECT_EQ(book.getBestAsk(), 98);
+    ASSERT_TRUE(hasOrder(10));
+    EXPECT_EQ(getOrder(10)->qty, 15);
+    EXPECT_EQ(getOrder(10)->orderType, OrderType::LIMIT);
+}
+
+TEST_F(OrderBookTest, StopCascade_FiresInPriorityOrder) {
+    std::vector<Trade> trades;
+    book.setTradeCallback([&](const Trade& t) { trades.push_back(t); });
+    for (Price p = 100; p <= 110; p++) {
+        book.addLimitOrder(p, p, 1, Side::SELL);
+    }
+
+    // FIFO within a trigger, lower triggers first; each fill moves the last price up a tick
+    book.addStopOrder(21, 101, 1, Side::BUY);
+    book.addStopOrder(22, 101, 1, Side::BUY);
+    book.addStopOrder(23, 103, 1, Side::BUY);
+    book.addStopOrder(24, 104, 1, Side::BUY);
+    book.addStopOrder(25, 107, 1, Side::BUY);
+
+    book.addMarketOrder(1, 2, Side::BUY);
+
+    std::vector<OrderId> takers;
+    for (const Trade& t : trades) {
+        takers.push_back(t.takerOrderId);
+    }
+    EXPECT_EQ(takers, (std::vector<OrderId>{1, 1, 21, 22, 23, 24}));
+    EXPECT_EQ(book.getLastTradePrice(), 105);
+    // 107 was never reached
+    EXPECT_TRUE(hasOrder(25));
+    EXPECT_EQ(book.getBestAsk(), 106);
+}
+
+TEST_F(OrderBookTest, StopCascade_LongChainRunsIteratively) {
+    // Every stop fires the next one: 20,000 activations from a single market order
+    const Price BASE = 1'000;
+    const int N = 20'000;
+    for (int i = 0; i <= N; i++) {
+        book.addLimitOrder(i + 1, BASE + i, 1, Side::SELL);
+    }
+    for (int i = 1; i <= N; i++) {
+        book.addStopOrder(100'000 + i, BASE + i - 1, 1, Side::BUY);
+    }
+
+    book.addMarketOrder(1'000'000, 1, Side::BUY);
+
+    EXPECT_EQ(book.getLastTradePrice(), BASE + N);
+    EXPECT_EQ(book.getBestAsk(), std::nullopt);
+    EXPECT_EQ(book.getOrderPool().getInUse(), 0);
+}
+
+TEST_F(OrderBookTest, Stops_CancelImmediateAndRejects) {
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 100, 10, Side::BUY);
+    ASSERT_EQ(book.getLastTradePrice(), 100);
+
+    // Only cancel acts on a pending stop
+    ASSERT_TRUE(book.addStopOrder(3, 90, 5, Side::SELL));
+    book.modifyOrder(3, 95, 1);
+    book.reduceOrder(3, 1);
+    EXPECT_EQ(getOrder(3)->qty, 5);
+    book.cancelOrder(3);
+    EXPECT_FALSE(hasOrder(3));
+
+    // Trigger already reached by the last trade: fires on arrival (nothing to hit, dropped)
+    ASSERT_TRUE(book.addStopOrder(4, 100, 5, Side::SELL));
+    EXPECT_FALSE(hasOrder(4));
+
+    EXPECT_FALSE(book.addStopOrder(5, 0, 5, Side::BUY));
+    EXPECT_FALSE(book.addStopOrder(5, MAX_PRICE, 5, Side::BUY));
+    EXPECT_FALSE(book.addStopLimitOrder(5, 101, 101, 0, Side::BUY));
+    EXPECT_FALSE(hasOrder(5));
+
+    // Through process(): trigger in stopPrice, limit in price
+    Command stop{6, 103, 5, OrderType::STOP_LIMIT, Side::BUY};
+    stop.stopPrice = 102;
+    book.process(stop);
+    book.addLimitOrder(7, 102, 1, Side::SELL);
+    book.addLimitOrder(8, 102, 1, Side::BUY);
+    ASSERT_TRUE(hasOrder(6));
+    EXPECT_EQ(getOrder(6)->orderType, OrderType::LIMIT);
+    EXPECT_EQ(book.getBestBid(), 103);
+
+    book.clear();
+    EXPECT_EQ(book.getLastTradePrice(), std::nullopt);
+}
+
 // =====================================================================
 // SECTION 5: CANCELLATIONS
 // Verify orders can be withdrawn before execution.
@@ -270,4 +509,637 @@ TEST_F(OrderBookTest, EmptyPriceLevel_IsRemovedAfterFill) {
 
     EXPECT_EQ(getAskDepth(), 0);
     EXPECT_EQ(getBidDepth(), 0);
-}
\ No newline at end of file
+}
+TEST_F(OrderBookTest, SparseExchangeIds_CancelAndMatch) {
+    // Scenario: Real exchange IDs are sparse 64-bit values
+    const OrderId idA = 0x7A3F000000000001ULL;
+    const OrderId idB = 0xFFFFFFFF00000042ULL;
+
+    book.addLimitOrder(idA, 100, 10, Side::SELL);
+    book.addLimitOrder(idB, 100, 10, Side::SELL);
+    book.cancelOrder(idA);
+
+    book.addLimitOrder(3, 100, 4, Side::BUY);
+
+    EXPECT_FALSE(hasOrder(idA));
+    ASSERT_TRUE(hasOrder(idB));
+    EXPECT_EQ(getOrder(idB)->qty, 6);
+}
+
+// =====================================================================
+// SECTION 5b: MODIFY / REPLACE
+// Verify size-downs keep priority and replaces lose it (or trade).
+// =====================================================================
+
+TEST_F(OrderBookTest, Modify_SizeDown_KeepsQueuePosition) {
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 100, 10, Side::SELL);
+
+    book.modifyOrder(1, 100, 4);
+
+    Order* first = getOrder(1);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->qty, 4);
+    EXPECT_EQ(first->parentLimit->head, first);
+    EXPECT_EQ(first->parentLimit->totalVolume, 14);
+
+    // Still first in line
+    book.addLimitOrder(3, 100, 4, Side::BUY);
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_EQ(getOrder(2)->qty, 10);
+}
+
+TEST_F(OrderBookTest, Modify_SizeUp_MovesToBackOfQueue) {
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 100, 10, Side::SELL);
+
+    book.modifyOrder(1, 100, 20);
+
+    Order* modified = getOrder(1);
+    EXPECT_EQ(modified->parentLimit->tail, modified);
+    EXPECT_EQ(modified->parentLimit->totalVolume, 30);
+
+    book.addLimitOrder(3, 100, 10, Side::BUY);
+    EXPECT_FALSE(hasOrder(2));
+    EXPECT_EQ(getOrder(1)->qty, 20);
+}
+
+TEST_F(OrderBookTest, Modify_RepriceThroughSpread_MatchesImmediately) {
+    book.addLimitOrder(1, 101, 5, Side::SELL);
+    book.addLimitOrder(2, 99, 8, Side::BUY);
+
+    // Bid re-priced through the ask: trades 5, rests 3 at $101
+    book.modifyOrder(2, 101, 8);
+
+    EXPECT_FALSE(hasOrder(1));
+    ASSERT_TRUE(hasOrder(2));
+    EXPECT_EQ(getOrder(2)->qty, 3);
+    EXPECT_EQ(getOrder(2)->price, 101);
+    EXPECT_EQ(getAskDepth(), 0);
+    EXPECT_EQ(getBidDepth(), 1);
+}
+
+TEST_F(OrderBookTest, Modify_PostOnlyThroughSpread_IsIgnored) {
+    int trades = 0;
+    book.setTradeCallback([&](const Trade&) { trades++; });
+    book.addLimitOrder(1, 105, 5, Side::SELL);
+    ASSERT_TRUE(book.addPostOnlyOrder(2, 100, 8, Side::BUY));
+    book.addLimitOrder(3, 100, 8, Side::BUY);
+
+    // Would take the ask: rejected, order 2 keeps price, size and queue position
+    book.modifyOrder(2, 106, 8);
+
+    EXPECT_EQ(trades, 0);
+    EXPECT_EQ(book.getBestAsk(), 105u);
+    ASSERT_TRUE(hasOrder(2));
+    EXPECT_EQ(getOrder(2)->price, 100);
+    EXPECT_EQ(getOrder(2)->qty, 8);
+    book.addMarketOrder(4, 8, Side::SELL);
+    EXPECT_FALSE(hasOrder(2));
+    EXPECT_TRUE(hasOrder(3));
+
+    // A re-price that stays passive still applies
+    ASSERT_TRUE(book.addPostOnlyOrder(5, 100, 8, Side::BUY));
+    book.modifyOrder(5, 104, 8);
+    EXPECT_EQ(getOrder(5)->price, 104);
+    EXPECT_EQ(book.getBestAsk(), 105u);
+}
+
+TEST_F(OrderBookTest, Modify_ToZero_Cancels) {
+    book.addLimitOrder(1, 100, 10, Side::BUY);
+
+    book.modifyOrder(1, 100, 0);
+
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_EQ(getBidDepth(), 0);
+}
+
+TEST_F(OrderBookTest, Reduce_KeepsQueuePosition_AndRemovesAtZero) {
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 100, 10, Side::SELL);
+
+    book.reduceOrder(1, 4);
+    ASSERT_TRUE(hasOrder(1));
+    EXPECT_EQ(getOrder(1)->qty, 6);
+
+    // Still first in line
+    book.addLimitOrder(3, 100, 6, Side::BUY);
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_EQ(getOrder(2)->qty, 10);
+
+    book.reduceOrder(2, 25);
+    EXPECT_FALSE(hasOrder(2));
+    EXPECT_EQ(getAskDepth(), 0);
+}
+
+TEST_F(OrderBookTest, Replace_NewIdSameSide) {
+    book.addLimitOrder(1, 100, 10, Side::BUY);
+    book.replaceOrder(1, 7, 98, 30);
+
+    EXPECT_FALSE(hasOrder(1));
+    ASSERT_TRUE(hasOrder(7));
+    EXPECT_EQ(getOrder(7)->side, Side::BUY);
+    EXPECT_EQ(getOrder(7)->price, 98);
+    EXPECT_EQ(book.getBestBid(), 98u);
+}
+
+// =====================================================================
+// SECTION 6: SLIDING PRICE LADDER
+// Verify prices far from the window and beyond 100,000 ticks behave.
+// =====================================================================
+
+TEST_F(OrderBookTest, LargeAbsolutePrices_MatchNormally) {
+    // Scenario: Fine-tick instrument quoted around 5,000,000 ticks
+    book.addLimitOrder(1, 5'000'000, 10, Side::SELL);
+    book.addLimitOrder(2, 5'000'001, 10, Side::SELL);
+
+    book.addLimitOrder(3, 5'000'001, 15, Side::BUY);
+
+    EXPECT_FALSE(hasOrder(1));
+    ASSERT_TRUE(hasOrder(2));
+    EXPECT_EQ(getOrder(2)->qty, 5);
+}
+
+TEST_F(OrderBookTest, FarLevels_LiveInOverflow_AndAreSweptInOrder) {
+    // Touch at 1,000,000; deep levels well outside the dense window
+    book.addLimitOrder(1, 1'000'000, 10, Side::SELL);
+    book.addLimitOrder(2, 1'000'000 + 50'000, 10, Side::SELL);
+    book.addLimitOrder(3, 1'000'000 + 90'000, 10, Side::SELL);
+
+    EXPECT_TRUE(askInWindow(1'000'000));
+    EXPECT_FALSE(askInWindow(1'000'000 + 50'000));
+    EXPECT_EQ(getAskDepth(), 3);
+
+    // Sweep: window must follow the touch out into the overflow levels
+    book.addMarketOrder(4, 25, Side::BUY);
+
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_FALSE(hasOrder(2));
+    ASSERT_TRUE(hasOrder(3));
+    EXPECT_EQ(getOrder(3)->qty, 5);
+    EXPECT_TRUE(askInWindow(1'000'000 + 90'000));
+}
+
+TEST_F(OrderBookTest, NewTouchOutsideWindow_Recenters) {
+    book.addLimitOrder(1, 200'000, 10, Side::BUY);
+    // Market rallies far above the window
+    book.addLimitOrder(2, 900'000, 10, Side::BUY);
+
+    EXPECT_TRUE(bidInWindow(900'000));
+    EXPECT_FALSE(bidInWindow(200'000));
+
+    // Cancel the touch: best bid falls back to the overflow level
+    book.cancelOrder(2);
+    book.addLimitOrder(3, 200'000, 4, Side::SELL);
+
+    ASSERT_TRUE(hasOrder(1));
+    EXPECT_EQ(getOrder(1)->qty, 6);
+    EXPECT_TRUE(bidInWindow(200'000));
+}
+
+// =====================================================================
+// SECTION 6b: TOP-N DEPTH CACHE
+// Verify the incrementally maintained L2 levels and touch accessors.
+// =====================================================================
+
+TEST_F(OrderBookTest, Depth_EmptyBook_HasNoTouch) {
+    EXPECT_FALSE(book.getBestBid().has_value());
+    EXPECT_FALSE(book.getBestAsk().has_value());
+    EXPECT_FALSE(book.getSpread().has_value());
+    EXPECT_TRUE(cachedDepth(Side::BUY, MAX_DEPTH_LEVELS).empty());
+}
+
+TEST_F(OrderBookTest, Depth_AggregatesLevels_BestFirst) {
+    book.addLimitOrder(1, 100, 10, Side::BUY);
+    book.addLimitOrder(2, 101, 20, Side::BUY);
+    book.addLimitOrder(3, 101, 5, Side::BUY);
+    book.addLimitOrder(4, 104, 7, Side::SELL);
+
+    std::vector<DepthLevel> bidsExpected{{101, 25, 2}, {100, 10, 1}};
+    EXPECT_EQ(cachedDepth(Side::BUY, MAX_DEPTH_LEVELS), bidsExpected);
+    EXPECT_EQ(cachedDepth(Side::BUY, 1).size(), 1);
+
+    EXPECT_EQ(book.getBestBid(), 101u);
+    EXPECT_EQ(book.getBestAsk(), 104u);
+    EXPECT_EQ(book.getSpread(), 3u);
+
+    // Partial fill at the touch only reduces the aggregate
+    book.addLimitOrder(5, 101, 21, Side::SELL);
+    std::vector<DepthLevel> afterFill{{101, 4, 1}, {100, 10, 1}};
+    EXPECT_EQ(cachedDepth(Side::BUY, MAX_DEPTH_LEVELS), afterFill);
+}
+
+TEST_F(OrderBookTest, Depth_CancelInsideTopN_RefillsFromDeeperLevels) {
+    // 12 ask levels: 100..111
+    for (OrderId id = 0; id < 12; id++) {
+        book.addLimitOrder(id, 100 + static_cast<Price>(id), 1, Side::SELL);
+    }
+    ASSERT_EQ(cachedDepth(Side::SELL, MAX_DEPTH_LEVELS).back().price, 109u);
+
+    book.cancelOrder(3); // level 103
+    auto depth = cachedDepth(Side::SELL, MAX_DEPTH_LEVELS);
+    ASSERT_EQ(depth.size(), MAX_DEPTH_LEVELS);
+    EXPECT_EQ(depth[3].price, 104u);
+    EXPECT_EQ(depth.back().price, 110u);
+}
+
+TEST_F(OrderBookTest, Depth_RandomFlow_MatchesLadderWalk) {
+    for (const Command& cmd : randomFlow(7, 20'000)) {
+        book.process(cmd);
+
+        ASSERT_EQ(cachedDepth(Side::BUY, MAX_DEPTH_LEVELS), walkDepth(Side::BUY, MAX_DEPTH_LEVELS)) << "after order " << cmd.id;
+        ASSERT_EQ(cachedDepth(Side::SELL, MAX_DEPTH_LEVELS), walkDepth(Side::SELL, MAX_DEPTH_LEVELS)) << "after order " << cmd.id;
+    }
+}
+
+// =====================================================================
+// SECTION 6c: SNAPSHOT / RESTORE
+// Verify a saved book restores with identical levels, queues and touch.
+// =====================================================================
+
+TEST_F(OrderBookTest, Snapshot_RoundTrip_PreservesLevelsAndFifo) {
+    std::string path = (std::filesystem::temp_directory_path() / "OrderBookTest.snap").string();
+
+    book.addLimitOrder(1, 100, 10, Side::BUY);
+    book.addLimitOrder(2, 100, 20, Side::BUY);
+    book.addLimitOrder(3, 99, 5, Side::BUY);
+    book.addLimitOrder(4, 105, 7, Side::SELL);
+    book.addLimitOrder(5, 900'000, 1, Side::SELL); // overflow level
+    book.saveSnapshot(path);
+
+    auto bids = walkDepth(Side::BUY, 100);
+    auto asks = walkDepth(Side::SELL, 100);
+
+    // Load replaces whatever is resting
+    book.addLimitOrder(99, 50, 1, Side::BUY);
+    book.loadSnapshot(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(walkDepth(Side::BUY, 100), bids);
+    EXPECT_EQ(walkDepth(Side::SELL, 100), asks);
+    EXPECT_EQ(cachedDepth(Side::BUY, MAX_DEPTH_LEVELS), bids);
+    EXPECT_EQ(book.getBestBid(), 100u);
+    EXPECT_EQ(book.getBestAsk(), 105u);
+    EXPECT_FALSE(hasOrder(99));
+
+    // Time priority survives: order 1 fills before order 2
+    book.addLimitOrder(6, 100, 15, Side::SELL);
+    EXPECT_FALSE(hasOrder(1));
+    ASSERT_TRUE(hasOrder(2));
+    EXPECT_EQ(getOrder(2)->qty, 15);
+}
+
+TEST_F(OrderBookTest, Snapshot_RoundTrip_KeepsPendingStopsAndLastTrade) {
+    std::string path = (std::filesystem::temp_directory_path() / "OrderBookTest.snap").string();
+
+    book.addLimitOrder(1, 100, 10, Side::BUY);
+    book.addLimitOrder(2, 102, 10, Side::SELL);
+    book.addLimitOrder(3, 103, 10, Side::SELL);
+    book.addMarketOrder(4, 1, Side::BUY); // last trade 102
+    ASSERT_TRUE(book.addStopOrder(5, 103, 12, Side::BUY));
+    ASSERT_TRUE(book.addStopLimitOrder(6, 103, 103, 4, Side::BUY));
+    ASSERT_TRUE(book.addStopOrder(7, 99, 3, Side::SELL));
+    book.saveSnapshot(path);
+
+    book.loadSnapshot(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(book.getLastTradePrice(), 102u);
+    ASSERT_TRUE(hasOrder(5));
+    ASSERT_TRUE(hasOrder(6));
+    ASSERT_TRUE(hasOrder(7));
+    EXPECT_EQ(getOrder(6)->orderType, OrderType::STOP_LIMIT);
+
+    // Trade at 103 fires both buy stops in FIFO order: the stop sweeps 103, the
+    // stop-limit finds nothing left at 103 and rests
+    book.addMarketOrder(8, 9, Side::BUY);
+    book.addMarketOrder(9, 1, Side::BUY);
+    EXPECT_FALSE(hasOrder(5));
+    ASSERT_TRUE(hasOrder(6));
+    EXPECT_EQ(getOrder(6)->orderType, OrderType::LIMIT);
+    EXPECT_EQ(book.getBestBid(), 103u);
+    EXPECT_TRUE(hasOrder(7));
+}
+
+TEST_F(OrderBookTest, Snapshot_Truncated_ThrowsAndLeavesBookEmpty) {
+    std::string path = (std::filesystem::temp_directory_path() / "OrderBookTest.snap").string();
+
+    book.addLimitOrder(1, 100, 10, Side::BUY);
+    book.addLimitOrder(2, 101, 10, Side::BUY);
+    book.saveSnapshot(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+    EXPECT_THROW(book.loadSnapshot(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_EQ(getBidDepth(), 0);
+    EXPECT_FALSE(book.getBestBid().has_value());
+}
+
+TEST_F(OrderBookTest, Snapshot_LevelCountsPastHeader_ThrowsWithoutReadingPastFile) {
+    std::string path = (std::filesystem::temp_directory_path() / "OrderBookTest.snap").string();
+
+    // Sizes agree with the header (3 levels, 1 order), but the first level claims 2
+    // orders and so swallows the whole body: the next level header lies past the end
+    SnapshotHeader header{SNAPSHOT_MAGIC, SNAPSHOT_VERSION, 0, 1, 3, 0, 100, MAX_PRICE, 0, 0, 0, 0, 0};
+    SnapshotLevel level{100, 2};
+    std::vector<SnapshotOrder> orders = {{1, 10, 0}, {2, 10, 0}};
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fwrite(&level, sizeof(level), 1, file);
+    std::fwrite(orders.data(), sizeof(SnapshotOrder), orders.size(), file);
+    std::fclose(file);
+    ASSERT_EQ(std::filesystem::file_size(path), sizeof(header) + 3 * sizeof(SnapshotLevel) + sizeof(SnapshotOrder));
+
+    EXPECT_THROW(book.loadSnapshot(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_EQ(getBidDepth(), 0);
+}
+
+TEST_F(OrderBookTest, Snapshot_DuplicateOrderId_Throws) {
+    std::string path = (std::filesystem::temp_directory_path() / "OrderBookTest.snap").string();
+
+    {
+        SnapshotWriter out(path);
+        const SnapshotOrder bid[] = {{1, 10, 0}};
+        const SnapshotOrder ask[] = {{2, 5, 0}, {1, 7, 0}};
+        out.writeLevel(Side::BUY, 100, bid, 1);
+        out.writeLevel(Side::SELL, 105, ask, 2);
+        out.close(100, 105);
+    }
+
+    EXPECT_THROW(book.loadSnapshot(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(hasOrder(1));
+    EXPECT_EQ(getBidDepth(), 0);
+    EXPECT_EQ(book.getOrderPool().getInUse(), 0);
+}
+
+// =====================================================================
+// SECTION 6d: BATCH SUBMISSION
+// Verify submitBatch() is indistinguishable from process() on each command.
+// =====================================================================
+
+TEST_F(OrderBookTest, SubmitBatch_MatchesSequentialProcessing) {
+    std::vector<Command> cmds = randomFlow(11, 20'000);
+    std::vector<Trade> sequentialTrades, batchTrades;
+
+    book.setTradeCallback([&](const Trade& t) { sequentialTrades.push_back(t); });
+    for (const Command& cmd : cmds) {
+        book.process(cmd);
+    }
+
+    Book batched(100000);
+    batched.setTradeCallback([&](const Trade& t) { batchTrades.push_back(t); });
+    // Uneven chunks, so look-ahead windows get cut at every possible offset
+    std::span<const Command> all(cmds);
+    for (size_t i = 0, chunk = 1; i < all.size(); i += chunk, chunk = chunk % 97 + 1) {
+        batched.submitBatch(all.subspan(i, std::min(chunk, all.size() - i)));
+    }
+
+    ASSERT_EQ(batchTrades.size(), sequentialTrades.size());
+    for (size_t i = 0; i < batchTrades.size(); i++) {
+        ASSERT_TRUE(sameTrade(batchTrades[i], sequentialTrades[i])) << "trade " << i;
+    }
+
+    for (Side side : {Side::BUY, Side::SELL}) {
+        std::vector<DepthLevel> batchLevels(MAX_DEPTH_LEVELS);
+        batchLevels.resize(batched.getDepth(side, batchLevels.data(), MAX_DEPTH_LEVELS));
+        EXPECT_EQ(batchLevels, cachedDepth(side, MAX_DEPTH_LEVELS));
+    }
+    EXPECT_EQ(batched.getBestBid(), book.getBestBid());
+    EXPECT_EQ(batched.getBestAsk(), book.getBestAsk());
+    EXPECT_EQ(batched.getOrderPool().getInUse(), book.getOrderPool().getInUse());
+}
+
+// =====================================================================
+// SECTION 6e: FLAT PRICE LADDER
+// Verify inline level headers behave exactly like the pooled ladder, including
+// across window slides that move headers and re-point their orders.
+// =====================================================================
+
+TEST(FlatPriceLadderTest, RandomFlowWithRecenters_MatchesPooledLadder) {
+    // A 64-tick window under a drifting mid: the touch keeps leaving the window and far
+    // orders land in the overflow map
+    const size_t WIDTH = 64;
+    Book pooled(100000, WIDTH);
+    BasicBook<CallbackListener, HashOrderIndex, FlatPriceLadder> flat(100000, WIDTH);
+
+    std::vector<Trade> pooledTrades, flatTrades;
+    pooled.setTradeCallback([&](const Trade& t) { pooledTrades.push_back(t); });
+    flat.setTradeCallback([&](const Trade& t) { flatTrades.push_back(t); });
+
+    for (const Command& cmd : randomFlow(20, 50'000, true)) {
+        pooled.process(cmd);
+        flat.process(cmd);
+        ASSERT_EQ(flat.getBestBid(), pooled.getBestBid()) << "order " << cmd.id;
+        ASSERT_EQ(flat.getBestAsk(), pooled.getBestAsk()) << "order " << cmd.id;
+    }
+
+    ASSERT_EQ(flatTrades.size(), pooledTrades.size());
+    for (size_t i = 0; i < flatTrades.size(); i++) {
+        ASSERT_TRUE(sameTrade(flatTrades[i], pooledTrades[i])) << "trade " << i;
+    }
+
+    for (Side side : {Side::BUY, Side::SELL}) {
+        std::vector<DepthLevel> flatLevels(MAX_DEPTH_LEVELS), pooledLevels(MAX_DEPTH_LEVELS);
+        flatLevels.resize(flat.getDepth(side, flatLevels.data(), MAX_DEPTH_LEVELS));
+        pooledLevels.resize(pooled.getDepth(side, pooledLevels.data(), MAX_DEPTH_LEVELS));
+        EXPECT_EQ(flatLevels, pooledLevels);
+    }
+    EXPECT_EQ(flat.getOrderPool().getInUse(), pooled.getOrderPool().getInUse());
+}
+
+TEST(FlatPriceLadderTest, RecenterRepointsQueuedOrders) {
+    FlatPriceLadder ladder(64);
+    Order a(1, 10, 5, OrderType::LIMIT, Side::SELL);
+    Order b(2, 10, 7, OrderType::LIMIT, Side::SELL);
+    ladder.insert(10)->addOrder(&a);
+    ladder.find(10)->addOrder(&b);
+
+    // 10 falls out of the window into the overflow map, then back in
+    ladder.recenter(1'000);
+    ASSERT_FALSE(ladder.inWindow(10));
+    EXPECT_EQ(a.parentLimit, ladder.find(10));
+    EXPECT_EQ(b.parentLimit, ladder.find(10));
+
+    ladder.recenter(20);
+    ASSERT_TRUE(ladder.inWindow(10));
+    EXPECT_EQ(a.parentLimit, ladder.find(10));
+    EXPECT_EQ(b.parentLimit, ladder.find(10));
+    EXPECT_EQ(ladder.find(10)->totalVolume, 12);
+
+    ladder.find(10)->removeOrder(&a);
+    EXPECT_EQ(ladder.find(10)->head, &b);
+    ladder.erase(10);
+    EXPECT_EQ(ladder.find(10), nullptr);
+    EXPECT_TRUE(ladder.empty());
+}
+
+// =====================================================================
+// SECTION 6f: VOLUME INDEX
+// Verify cumulative-volume, sweep-price and VWAP queries, with and without the
+// Fenwick index, including overflow levels and window slides.
+// =====================================================================
+
+TEST_F(OrderBookTest, VolumeQueries_WithAndWithoutIndex) {
+    book.addLimitOrder(1, 100, 4, Side::SELL);
+    book.addLimitOrder(2, 100, 6, Side::SELL);
+    book.addLimitOrder(3, 102, 5, Side::SELL);
+    book.addLimitOrder(4, 105, 20, Side::SELL);
+    book.addLimitOrder(5, 99, 8, Side::BUY);
+    book.addLimitOrder(6, 97, 12, Side::BUY);
+
+    for (bool indexed : {false, true}) {
+        book.enableVolumeIndex(indexed);
+
+        EXPECT_EQ(book.getVolumeThrough(Side::SELL, 99), 0);
+        EXPECT_EQ(book.getVolumeThrough(Side::SELL, 101), 10);
+        EXPECT_EQ(book.getVolumeThrough(Side::SELL, 102), 15);
+        EXPECT_EQ(book.getVolumeThrough(Side::SELL, MAX_PRICE), 35);
+        EXPECT_EQ(book.getVolumeThrough(Side::BUY, 98), 8);
+        EXPECT_EQ(book.getVolumeThrough(Side::BUY, 0), 20);
+
+        EXPECT_EQ(book.getSweepPrice(Side::SELL, 10), 100);
+        EXPECT_EQ(book.getSweepPrice(Side::SELL, 12), 102);
+        EXPECT_EQ(book.getSweepPrice(Side::SELL, 35), 105);
+        EXPECT_EQ(book.getSweepPrice(Side::SELL, 36), std::nullopt);
+        EXPECT_EQ(book.getSweepPrice(Side::BUY, 9), 97);
+        EXPECT_EQ(book.getSweepPrice(Side::BUY, 0), std::nullopt);
+
+        EXPECT_DOUBLE_EQ(*book.getFillVwap(Side::SELL, 12), (10 * 100 + 2 * 102) / 12.0);
+        EXPECT_DOUBLE_EQ(*book.getFillVwap(Side::BUY, 20), (8 * 99 + 12 * 97) / 20.0);
+        EXPECT_EQ(book.getFillVwap(Side::BUY, 21), std::nullopt);
+    }
+
+    // Fills and cancels flow into the index
+    book.addMarketOrder(7, 12, Side::BUY);
+    book.cancelOrder(6);
+    EXPECT_EQ(book.getVolumeThrough(Side::SELL, 102), 3);
+    EXPECT_EQ(book.getSweepPrice(Side::SELL, 4), 105);
+    EXPECT_EQ(book.getVolumeThrough(Side::BUY, 0), 8);
+
+    book.clear();
+    EXPECT_EQ(book.getVolumeThrough(Side::SELL, MAX_PRICE), 0);
+    EXPECT_EQ(book.getSweepPrice(Side::BUY, 1), std::nullopt);
+}
+
+TEST(VolumeIndexTest, RandomFlowWithRecenters_MatchesLevelWalk) {
+    // A 64-tick window under a drifting mid, so queries span the window and the
+    // overflow map, and the index is rebuilt on every slide
+    const size_t WIDTH = 64;
+    Book walked(100000, WIDTH);
+    Book indexed(100000, WIDTH);
+    indexed.enableVolumeIndex(true);
+    // Index switched on half-way, over a populated book (built from the ladders)
+    Book late(100000, WIDTH);
+
+    const std::vector<Command> cmds = randomFlow(23, 30'000, true);
+    // Queries come from their own stream, centred on the latest limit price (tracks the mid)
+    std::mt19937 rng(23);
+    Price center = 2'000;
+
+    for (size_t i = 0; i < cmds.size(); i++) {
+        const Command& cmd = cmds[i];
+        walked.process(cmd);
+        indexed.process(cmd);
+        late.process(cmd);
+        if (i == cmds.size() / 2)
+            late.enableVolumeIndex(true);
+        if (cmd.type == OrderType::LIMIT)
+            center = std::max<Price>(cmd.price, 500);
+
+        // `walked` never has an index: every query below is checked against a level walk
+        for (Side s : {Side::BUY, Side::SELL}) {
+            Price through = center - 500 + rng() % 1'000;
+            std::uint64_t qty = 1 + rng() % 2'000;
+            for (const Book* book : {&indexed, &late}) {
+                ASSERT_EQ(book->getVolumeThrough(s, through), walked.getVolumeThrough(s, through)) << "command " << i;
+                ASSERT_EQ(book->getSweepPrice(s, qty), walked.getSweepPrice(s, qty)) << "command " << i;
+                ASSERT_EQ(book->getFillVwap(s, qty), walked.getFillVwap(s, qty)) << "command " << i;
+            }
+        }
+    }
+}
+
+// =====================================================================
+// SECTION 7: BATCHED EXECUTION REPORTS
+// Verify fills are appended to the execution buffer with maker state.
+// =====================================================================
+
+TEST(ExecutionBufferTest, Sweep_RecordsMakerRemainingAndLevelEmptied) {
+    BasicBook<ExecutionBuffer> book(1000);
+
+    book.addLimitOrder(1, 100, 10, Side::SELL);
+    book.addLimitOrder(2, 100, 10, Side::SELL);
+    book.addLimitOrder(3, 101, 10, Side::SELL);
+
+    // Takes all of $100 and 5 of $101
+    book.addMarketOrder(4, 25, Side::BUY);
+
+    std::vector<Trade> fills;
+    size_t drained = book.getListener().drain(
+        [&](std::span<const Trade> batch) { fills.assign(batch.begin(), batch.end()); });
+
+    ASSERT_EQ(drained, 3);
+    EXPECT_TRUE(book.getListener().empty());
+
+    EXPECT_EQ(fills[0].makerOrderId, 1);
+    EXPECT_EQ(fills[0].makerRemaining, 0);
+    EXPECT_FALSE(fills[0].levelEmptied); // Order #2 still rests at $100
+
+    EXPECT_EQ(fills[1].makerOrderId, 2);
+    EXPECT_TRUE(fills[1].levelEmptied);
+
+    EXPECT_EQ(fills[2].takerOrderId, 4);
+    EXPECT_EQ(fills[2].price, 101);
+    EXPECT_EQ(fills[2].quantity, 5);
+    EXPECT_EQ(fills[2].makerRemaining, 5);
+    EXPECT_FALSE(fills[2].levelEmptied);
+}
+
+// =====================================================================
+// SECTION 8: OBJECT POOL GROWTH
+// Verify the pool grows instead of handing out nullptr.
+// =====================================================================
+
+TEST(ObjectPoolTest, Exhaustion_GrowsByChunk_WithoutMovingObjects) {
+    ObjectPool<Order> pool(4, 4);
+
+    // Chunks are rounded up to whole pages, so fill whatever the first chunk holds
+    size_t firstChunk = pool.getCapacity();
+    std::vector<Order*> orders;
+    for (OrderId id = 0; id < firstChunk; id++) {
+        orders.push_back(pool.acquire(id, 100, 1, OrderType::LIMIT, Side::BUY));
+    }
+    EXPECT_EQ(pool.getChunkCount(), 1);
+
+    // Next acquire must allocate a second chunk
+    Order* extra = pool.acquire(firstChunk, 100, 1, OrderType::LIMIT, Side::BUY);
+    ASSERT_NE(extra, nullptr);
+    EXPECT_EQ(pool.getChunkCount(), 2);
+
+    // Earlier objects are untouched
+    for (OrderId id = 0; id < firstChunk; id++) {
+        EXPECT_EQ(orders[id]->orderId, id);
+    }
+
+    pool.release(extra);
+    pool.release(orders[0]);
+    EXPECT_EQ(pool.getInUse(), firstChunk - 1);
+    EXPECT_EQ(pool.getHighWater(), firstChunk + 1);
+}
+
+TEST(ObjectPoolTest, Book_BeyondMaxOrders_DoesNotCrash) {
+    // Scenario: More resting orders than the book was sized for
+    BasicBook<NoopListener> small(8);
+
+    for (OrderId id = 1; id <= 1000; id++) {
+        small.addLimitOrder(id, 100 + (id % 50), 1, Side::BUY);
+    }
+
+    EXPECT_EQ(small.getOrderPool().getInUse(), 1000);
+}
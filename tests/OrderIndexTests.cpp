@@ -0,0 +1,86 @@
+#include "OrderIndex.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+TEST(OrderIndexTest, DirectIndex_GrowsInsteadOfWritingOutOfBounds) {
+    DirectOrderIndex index(16);
+    Order order(1'000'000, 100, 1, OrderType::LIMIT, Side::BUY);
+
+    index.insert(1'000'000, &order);
+
+    EXPECT_EQ(index.find(1'000'000), &order);
+    EXPECT_EQ(index.find(5'000'000), nullptr);
+}
+
+TEST(OrderIndexTest, HashIndex_SparseIds_RoundTrip) {
+    HashOrderIndex index(4);
+    Order a(0xDEADBEEF00000001ULL, 100, 1, OrderType::LIMIT, Side::BUY);
+    Order b(0xFFFFFFFFFFFFFFFFULL, 100, 1, OrderType::LIMIT, Side::BUY);
+
+    index.insert(a.orderId, &a);
+    index.insert(b.orderId, &b);
+    EXPECT_EQ(index.find(a.orderId), &a);
+    EXPECT_EQ(index.find(b.orderId), &b);
+
+    index.erase(a.orderId);
+    EXPECT_EQ(index.find(a.orderId), nullptr);
+    EXPECT_EQ(index.find(b.orderId), &b);
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST(OrderIndexTest, HashIndex_StridedIds_SpreadAcrossHomeSlots) {
+    // Sequence number shifted over a venue tag: the low 8 bits carry almost no entropy
+    constexpr size_t N = 50'000;
+    HashOrderIndex index(N);
+    Order order(1, 100, 1, OrderType::LIMIT, Side::BUY);
+
+    for (OrderId seq = 1; seq <= N; seq++) {
+        index.insert((seq << 8) | (seq % 4), &order);
+    }
+
+    EXPECT_EQ(index.size(), N);
+    for (OrderId seq = 1; seq <= N; seq++) {
+        ASSERT_EQ(index.find((seq << 8) | (seq % 4)), &order);
+    }
+    // An identity-style hash would pile these onto 1/64 of the home slots (chains in the thousands)
+    EXPECT_LT(index.getMaxProbeDistance(), 64);
+}
+
+TEST(OrderIndexTest, HashIndex_RandomChurn_MatchesReferenceMap) {
+    // Small table + heavy churn exercises Robin Hood displacement, backward shift and growth
+    HashOrderIndex index(64);
+    std::unordered_map<OrderId, Order*> reference;
+    std::vector<Order> storage;
+    storage.reserve(4096);
+    for (int i = 0; i < 4096; i++) {
+        storage.emplace_back(i, 100, 1, OrderType::LIMIT, Side::BUY);
+    }
+
+    std::mt19937_64 rng(11);
+    std::vector<OrderId> live;
+
+    for (int i = 0; i < 50'000; i++) {
+        if (live.empty() || rng() % 2 == 0) {
+            OrderId id = rng();
+            Order* order = &storage[id % storage.size()];
+            index.insert(id, order);
+            reference[id] = order;
+            live.push_back(id);
+        } else {
+            size_t pick = rng() % live.size();
+            OrderId id = live[pick];
+            live[pick] = live.back();
+            live.pop_back();
+
+            index.erase(id);
+            reference.erase(id);
+        }
+
+        OrderId probe = live.empty() ? rng() : live[rng() % live.size()];
+        auto it = reference.find(probe);
+        ASSERT_EQ(index.find(probe), it == reference.end() ? nullptr : it->second);
+    }
+
+    EXPECT_EQ(index.size(), reference.size());
+}
@@ -0,0 +1,45 @@
+#include "PerfCounters.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+// Counters may legitimately be missing (VMs without a PMU, containers, strict
+// perf_event_paranoid): both outcomes must leave a usable object
+TEST(PerfCountersTest, CountsOrDegradesGracefully) {
+    PerfCounters counters;
+
+    counters.start();
+    volatile std::uint64_t sink = 0;
+    for (std::uint64_t i = 0; i < 1'000'000; i++) {
+        sink = sink + i;
+    }
+    PerfSample sample = counters.stop();
+
+    if (counters.isAvailable()) {
+        EXPECT_TRUE(counters.getError().empty());
+        if (sample.has(PerfEvent::INSTRUCTIONS)) {
+            EXPECT_GT(sample.get(PerfEvent::INSTRUCTIONS), 1'000'000u);
+        }
+    } else {
+        EXPECT_FALSE(counters.getError().empty());
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            EXPECT_FALSE(sample.has(static_cast<PerfEvent>(i)));
+        }
+    }
+}
+
+TEST(PerfCountersTest, Add_KeepsOnlyEventsCountedEverywhere) {
+    PerfSample a, b, total;
+    a.values[0] = 10;
+    a.valid[0] = a.valid[1] = true;
+    b.values[0] = 5;
+    b.valid[0] = true;
+
+    total.add(a);
+    total.add(b);
+
+    EXPECT_EQ(total.regions, 2u);
+    EXPECT_TRUE(total.has(PerfEvent::CYCLES));
+    EXPECT_EQ(total.get(PerfEvent::CYCLES), 15u);
+    EXPECT_FALSE(total.has(PerfEvent::INSTRUCTIONS));
+}
@@ -0,0 +1,137 @@
+#include "Book.h"
+#include "MatchingLoop.h"
+#include "SPSCQueue.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <span>
+#include <thread>
+
+// =====================================================================
+// SECTION 1: RING BUFFER SEMANTICS
+// =====================================================================
+
+TEST(SPSCQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    SPSCQueue<int> queue(1000);
+    EXPECT_EQ(queue.getCapacity(), 1024);
+}
+
+TEST(SPSCQueueTest, PushPop_PreservesFifoOrder) {
+    SPSCQueue<int> queue(4);
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_TRUE(queue.push(3));
+
+    int out = 0;
+    ASSERT_TRUE(queue.pop(out));
+    EXPECT_EQ(out, 1);
+    ASSERT_TRUE(queue.pop(out));
+    EXPECT_EQ(out, 2);
+    ASSERT_TRUE(queue.pop(out));
+    EXPECT_EQ(out, 3);
+    EXPECT_FALSE(queue.pop(out));
+}
+
+TEST(SPSCQueueTest, Push_FailsWhenFull_AndWrapsAround) {
+    SPSCQueue<int> queue(4);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(99));
+
+    // Free two slots, then wrap past the end of the buffer
+    int out = 0;
+    queue.pop(out);
+    queue.pop(out);
+    EXPECT_TRUE(queue.push(4));
+    EXPECT_TRUE(queue.push(5));
+
+    std::vector<int> drained;
+    queue.consume([&](int v) { drained.push_back(v); });
+    EXPECT_EQ(drained, (std::vector<int>{2, 3, 4, 5}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, CrossThread_DeliversEveryItemInOrder) {
+    constexpr int COUNT = 200'000;
+    SPSCQueue<int> queue(64);
+
+    std::thread producer([&] {
+        for (int i = 0; i < COUNT; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    while (expected < COUNT) {
+        int out;
+        if (queue.pop(out)) {
+            ordered &= (out == expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+}
+
+// =====================================================================
+// SECTION 2: MATCHING LOOP
+// =====================================================================
+
+TEST(MatchingLoopTest, Stop_DrainsEveryEnqueuedCommand) {
+    Book book(1000);
+    SPSCQueue<Command> ingress(16);
+    int trades = 0;
+    book.setTradeCallback([&](const Trade&) { trades++; });
+
+    MatchingLoop matcher(book, ingress);
+    matcher.start(0);
+
+    for (OrderId id = 1; id <= 100; id++) {
+        Command cmd{id, 100, 10, OrderType::LIMIT, (id % 2) ? Side::SELL : Side::BUY};
+        while (!ingress.push(cmd)) {
+            std::this_thread::yield();
+        }
+    }
+
+    matcher.stop();
+
+    // Every BUY crosses the SELL resting just before it
+    EXPECT_TRUE(ingress.empty());
+    EXPECT_EQ(trades, 50);
+}
+
+TEST(MatchingLoopTest, BatchHook_DrainsExecutionBufferOnMatchingThread) {
+    BasicBook<ExecutionBuffer> book(1000);
+    SPSCQueue<Command> ingress(16);
+    size_t published = 0;
+    size_t largestBacklog = 0;
+
+    MatchingLoop matcher(book, ingress, [&]() {
+        largestBacklog = std::max(largestBacklog, book.getListener().size());
+        book.getListener().drain([&](std::span<const Trade> fills) { published += fills.size(); });
+    });
+    matcher.start(0);
+
+    for (OrderId id = 1; id <= 1000; id++) {
+        Command cmd{id, 100, 10, OrderType::LIMIT, (id % 2) ? Side::SELL : Side::BUY};
+        while (!ingress.push(cmd)) {
+            std::this_thread::yield();
+        }
+    }
+
+    matcher.stop();
+
+    // Every fill was published, and never more than one batch of commands' worth piled up
+    EXPECT_EQ(published, 500);
+    EXPECT_TRUE(book.getListener().empty());
+    EXPECT_LE(largestBacklog, 64);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Types.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Shared helpers for the randomised "two implementations must agree" tests.
+
+// Field-by-field Trade equality (Trade has no operator==)
+inline bool sameTrade(const Trade& a, const Trade& b) {
+    return a.takerOrderId == b.takerOrderId && a.makerOrderId == b.makerOrderId && a.price == b.price &&
+           a.quantity == b.quantity && a.makerRemaining == b.makerRemaining && a.levelEmptied == b.levelEmptied;
+}
+
+// Deterministic limit / cancel / modify / market flow (50 / 30 / 10 / 10), command i
+// carrying order id i + 1. Cancels and modifies pick a live id at random, including
+// ids that have since traded away; a modify to quantity 0 cancels.
+//  * Fixed band: bids in [980, 1010), asks in [1000, 1030), so some orders cross.
+//  * Drifting mid (`driftingMid`): prices follow a random walk over [1000, 3000] and
+//    1 in 20 orders lands 200-600 ticks away, so a narrow ladder window keeps sliding
+//    and far levels go to its overflow map.
+inline std::vector<Command> randomFlow(unsigned seed, size_t count, bool driftingMid = false) {
+    std::mt19937 rng(seed);
+    std::vector<Command> cmds;
+    cmds.reserve(count);
+    std::vector<OrderId> live;
+    Price mid = 2'000;
+
+    for (OrderId id = 1; id <= count; id++) {
+        Side side = (rng() % 2) ? Side::BUY : Side::SELL;
+        Price price;
+        if (driftingMid) {
+            mid = std::clamp<Price>(mid + rng() % 9 - 4, 1'000, 3'000);
+            Price spread = (rng() % 20 == 0) ? 200 + rng() % 400 : rng() % 40;
+            price = (side == Side::BUY) ? mid - spread : mid + spread;
+        } else {
+            price = (side == Side::BUY) ? 980 + rng() % 30 : 1000 + rng() % 30;
+        }
+
+        int op = rng() % 10;
+        if (op < 5 || live.empty()) {
+            cmds.push_back({id, price, 1 + static_cast<Quantity>(rng() % 50), OrderType::LIMIT, side});
+            live.push_back(id);
+        } else if (op < 8) {
+            size_t pick = rng() % live.size();
+            cmds.push_back({live[pick], 0, 0, OrderType::CANCEL, Side::BUY});
+            live[pick] = live.back();
+            live.pop_back();
+        } else if (op < 9) {
+            cmds.push_back({live[rng() % live.size()], price, static_cast<Quantity>(rng() % 50), OrderType::MODIFY, side});
+        } else {
+            cmds.push_back({id, 0, 1 + static_cast<Quantity>(rng() % 200), OrderType::MARKET, side});
+        }
+    }
+
+    return cmds;
+}